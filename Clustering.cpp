@@ -0,0 +1,222 @@
+//================================================================
+// Clustering.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the Clustering.cpp file that implements single-linkage
+// clustering. Edges are taken as (w, v1, v2) tuples, so the heap and
+// the sort order them by weight, then by vertices: ties are always
+// broken the same way and every method agrees with the dendrogram.
+//================================================================
+
+#include "Clustering.h"
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <stdexcept>
+
+namespace {
+
+typedef std::tuple<int, int, int> WeightedEdge;    //(w, v1, v2)
+
+//===========================================
+// collectEdges
+// this method lists every edge of the view once, without self-loops.
+// params: the view, the edges (output)
+// return value: none.
+//===========================================
+void collectEdges(const GraphView &view, std::vector<WeightedEdge> &out) {
+    out.clear();
+    out.reserve(view.numArcs() / 2);
+    for (int u = 0; u < view.size(); ++u) {
+        const int *t = view.targets(u);
+        const int *w = view.weights(u);
+        for (int a = 0, d = view.degree(u); a < d; ++a) {
+            #ifdef DIRECTED_GRAPH
+            if (t[a] != u)
+            #else
+            if (t[a] > u)
+            #endif
+                out.emplace_back(w[a], u, t[a]);
+        }
+    }
+}
+//===========================================
+// labelSets
+// this method numbers the sets of S in the order of their smallest
+// vertex, as components does.
+// params: the union-find, vertex count, the result (output)
+// return value: none.
+//===========================================
+void labelSets(ArrayDSU &S, const int V, ComponentsResult &result) {
+    std::vector<int> id(V, -1);
+
+    result.label.resize(V);
+    result.size.clear();
+    for (int v = 0; v < V; ++v) {
+        int &c = id[S.find_(v)];
+        if (c == -1) {
+            c = (int)result.size.size();
+            result.size.push_back(0);
+        }
+        result.label[v] = c;
+        result.size[c]++;
+    }
+}
+//===========================================
+// replay
+// this method unites the two sides of the first n merges of a
+// dendrogram, each side through one of its vertices.
+// params: the dendrogram, merge count, the result (output)
+// return value: none.
+//===========================================
+void replay(const Dendrogram &tree, const int n, ComponentsResult &result) {
+    const int V = tree.vert_count;
+    std::vector<int> leaf(V + n);      //a vertex under each node
+    ArrayDSU S(V);
+
+    for (int v = 0; v < V; ++v)
+        leaf[v] = v;
+    for (int i = 0; i < n; ++i) {
+        leaf[V + i] = leaf[tree.left[i]];
+        S.union_(leaf[tree.left[i]], leaf[tree.right[i]]);
+    }
+    labelSets(S, V, result);
+}
+
+}
+
+//===========================================
+// cut
+// this method gives the partition into k clusters (or into every
+// component, if the graph has more than k).
+// params: cluster count, the result (output)
+// return value: none.
+//===========================================
+void Dendrogram::cut(const int k, ComponentsResult &result) const {
+    if (k < 1 or k > std::max(1, vert_count))
+        throw std::invalid_argument("cut - Invalid Cluster Count");
+
+    replay(*this, std::max(0, std::min(merges(), vert_count - k)), result);
+}
+//===========================================
+// cutAt
+// this method gives the partition made by the merges of height at
+// most threshold. The heights never decrease along the merges.
+// params: the distance threshold, the result (output)
+// return value: none.
+//===========================================
+void Dendrogram::cutAt(const int threshold, ComponentsResult &result) const {
+    int n = (int)(std::upper_bound(height.begin(), height.end(), threshold) - height.begin());
+    replay(*this, n, result);
+}
+//===========================================
+// singleLinkage
+// this method runs the whole of Kruskal and records every merge.
+// params: the view, the dendrogram (output)
+// return value: none.
+//===========================================
+void singleLinkage(const GraphView &view, Dendrogram &tree) {
+    const int V = view.size();
+    std::vector<WeightedEdge> edges;
+    std::vector<int> node(V);       //dendrogram node of each root
+    ArrayDSU S(V);
+
+    collectEdges(view, edges);
+    std::sort(edges.begin(), edges.end());
+
+    tree = Dendrogram();
+    tree.vert_count = V;
+    for (int v = 0; v < V; ++v)
+        node[v] = v;
+
+    for (const auto& e : edges) {
+        if (tree.merges() == V - 1)
+            break;
+
+        int a = S.find_(std::get<1>(e));
+        int b = S.find_(std::get<2>(e));
+        if (a == b)
+            continue;
+
+        S.union_(a, b);
+        int r = S.find_(a);
+        tree.left.push_back(node[a]);
+        tree.right.push_back(node[b]);
+        tree.height.push_back(std::get<0>(e));
+        tree.size.push_back(S.size_(r));
+        node[r] = V + tree.merges() - 1;
+    }
+}
+//===========================================
+// clusterK
+// this method runs Kruskal until k components remain. The V - k merges
+// take at least as many edges: when that is a small share of them the
+// edges are heapified (linear) and only those popped are paid for in
+// log E, otherwise they are sorted once.
+// params: the view, cluster count, the result (output)
+// return value: none.
+//===========================================
+void clusterK(const GraphView &view, const int k, ComponentsResult &result) {
+    const int V = view.size();
+    std::vector<WeightedEdge> edges;
+    ArrayDSU S(V);
+    int count = V;
+
+    if (k < 1 or k > std::max(1, V))
+        throw std::invalid_argument("clusterK - Invalid Cluster Count");
+
+    collectEdges(view, edges);
+
+    if ((size_t)std::max(V - k, 0) * CLUSTER_HEAP_FRACTION <= edges.size()) {
+        std::make_heap(edges.begin(), edges.end(), std::greater<WeightedEdge>());
+        while (count > k and !edges.empty()) {
+            std::pop_heap(edges.begin(), edges.end(), std::greater<WeightedEdge>());
+            if (S.union_(std::get<1>(edges.back()), std::get<2>(edges.back())))
+                --count;
+            edges.pop_back();
+        }
+    }
+    else {
+        std::sort(edges.begin(), edges.end());
+        for (const auto& e : edges) {
+            if (count == k)
+                break;
+            if (S.union_(std::get<1>(e), std::get<2>(e)))
+                --count;
+        }
+    }
+    labelSets(S, V, result);
+}
+//===========================================
+// clusterThreshold
+// this method unites the ends of every edge of weight <= threshold;
+// the order does not matter, so nothing is sorted.
+// params: the view, the distance threshold, the result (output)
+// return value: none.
+//===========================================
+void clusterThreshold(const GraphView &view, const int threshold, ComponentsResult &result) {
+    const int V = view.size();
+    ArrayDSU S(V);
+
+    for (int u = 0; u < V; ++u) {
+        const int *t = view.targets(u);
+        const int *w = view.weights(u);
+        for (int a = 0, d = view.degree(u); a < d; ++a) {
+            if (w[a] <= threshold)
+                S.union_(u, t[a]);
+        }
+    }
+    labelSets(S, V, result);
+}
+
+void singleLinkage(const Graph &g, Dendrogram &tree) {
+    singleLinkage(GraphView(g), tree);
+}
+
+void clusterK(const Graph &g, const int k, ComponentsResult &result) {
+    clusterK(GraphView(g), k, result);
+}
+
+void clusterThreshold(const Graph &g, const int threshold, ComponentsResult &result) {
+    clusterThreshold(GraphView(g), threshold, result);
+}
@@ -0,0 +1,59 @@
+//================================================================
+// Clustering.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for single-linkage clustering. Cutting
+// the k - 1 heaviest edges of a minimum spanning forest is the same
+// as stopping Kruskal when k components remain, so the clusterings are
+// Kruskal runs that stop early:
+//     clusterK          heapifies the edges (linear) and pops only
+//                       until k components remain, when that takes
+//                       few of them; sorts them once when k is small
+//     clusterThreshold  needs no order at all: the clusters at
+//                       distance t are the components of the edges of
+//                       weight <= t
+//     singleLinkage     the whole Kruskal, recorded as a dendrogram
+// Partitions are returned as a ComponentsResult, labelled in the order
+// of the smallest vertex of each cluster.
+//================================================================
+
+#include "Graph.h"
+#include "GraphView.h"
+#include "Components.h"
+#include <vector>
+
+#ifndef CLUSTERING_H
+#define CLUSTERING_H
+
+//clusterK uses the heap when the V - k merges are at most
+//1/CLUSTER_HEAP_FRACTION of the edges, and a sort otherwise (a pop
+//costs more than a sorted edge, and the pops outgrow the merges as k
+//shrinks)
+const int CLUSTER_HEAP_FRACTION = 6;
+
+//Merges in the order Kruskal made them. Vertices are nodes 0 .. V - 1
+//and merge i creates node V + i from nodes left[i] and right[i]. A
+//disconnected graph has fewer than V - 1 merges.
+struct Dendrogram {
+    int vert_count = 0;
+    std::vector<int> left;
+    std::vector<int> right;
+    std::vector<int> height;    //weight of the edge that made the merge
+    std::vector<int> size;      //vertices under the new node
+
+    int     merges  (void) const { return (int)height.size(); }
+    //Partitions after the first V - k merges, or the merges of height <= t
+    void    cut     (const int k, ComponentsResult &result) const;
+    void    cutAt   (const int threshold, ComponentsResult &result) const;
+};
+
+void    singleLinkage   (const GraphView &view, Dendrogram &tree);
+//At least k clusters: more if the graph has more than k components
+void    clusterK        (const GraphView &view, const int k, ComponentsResult &result);
+void    clusterThreshold(const GraphView &view, const int threshold, ComponentsResult &result);
+
+void    singleLinkage   (const Graph &g, Dendrogram &tree);
+void    clusterK        (const Graph &g, const int k, ComponentsResult &result);
+void    clusterThreshold(const Graph &g, const int threshold, ComponentsResult &result);
+
+#endif
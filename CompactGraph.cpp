@@ -0,0 +1,324 @@
+//================================================================
+// CompactGraph.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the CompactGraph.cpp file that implements the compressed
+// read-only adjacency. Each row is stored as
+//     zigzag(first - v), first gap, second gap, ...
+// in LEB128 varints (7 bits per byte, high bit set on all but the
+// last byte). Rows are sorted, so the gaps are small and most of them
+// fit in one byte, more so once the vertices have been reordered for
+// locality. Decoding is a byte load and a compare on the fast path.
+//================================================================
+
+#include "CompactGraph.h"
+#include "MSTCore.h"
+#include "Parallel.h"
+#include <stdexcept>
+#include <algorithm>
+
+//===========================================
+// Constructor
+// this method compresses the adjacency of any backend.
+// params: Graph &g
+// return value: none
+//===========================================
+CompactGraph::CompactGraph(const Graph &g) : \
+    vert_count(g.size()), edge_count(g.numEdges()), max_weight(g.maxWeight()), weight_width(1) {
+    Adjacency adj;
+    std::vector<std::pair<int, int>> row;
+
+    adj.offset.assign(vert_count + 1, 0);
+    for (int v = 0; v < vert_count; ++v) {
+        g.getNeighbors(v, row);
+        adj.arcs.insert(adj.arcs.end(), row.begin(), row.end());
+        adj.offset[v + 1] = adj.arcs.size();
+    }
+    encode(adj, 1);
+}
+//===========================================
+// Constructor
+// this method builds the graph straight from an edge list, with the
+// same checks as insertEdge. Undirected edges are stored both ways
+// unless DIRECTED_GRAPH is defined.
+// params: vertices, list of (v1, v2, w) edges, thread count
+// return value: none
+//===========================================
+CompactGraph::CompactGraph(const int V, const std::vector<std::tuple<int, int, int>> &edge_list, const int threads) : \
+    vert_count(V), edge_count((int)edge_list.size()), max_weight(-1), weight_width(1) {
+    if (V < 0)
+        throw std::invalid_argument("CompactGraph - Invalid Size");
+
+    Adjacency adj = buildAdjacency(V, edge_list, threads);
+    encode(adj, threads);
+}
+//===========================================
+// Constructor
+// this method parses the rest of the stream (up to E edges, as
+// operator>> would) and builds the graph, all in parallel.
+// params: vertices, edges, istream &is, thread count
+// return value: none
+//===========================================
+CompactGraph::CompactGraph(const int V, const int E, std::istream &is, const int threads) : \
+    vert_count(V), edge_count(E), max_weight(-1), weight_width(1) {
+    if (V < 0)
+        throw std::invalid_argument("CompactGraph - Invalid Size");
+
+    Adjacency adj = buildAdjacency(V, readEdgesParallel(is, E, threads), threads);
+    encode(adj, threads);
+}
+//===========================================
+// encode
+// this method sorts every row and writes the byte streams. Each thread
+// encodes a block of vertices into its own buffers, which are then
+// copied one after the other.
+// params: the adjacency (its rows get sorted), thread count
+// return value: none
+//===========================================
+void CompactGraph::encode(Adjacency &adj, const int threads) {
+    for (const auto& arc : adj.arcs)
+        max_weight = std::max(max_weight, arc.second);
+    weight_width = (max_weight < (1 << 8)) ? 1 : (max_weight < (1 << 16)) ? 2 : 4;
+
+    const int T = std::max(1, threads);
+    std::vector<std::vector<uint8_t>> part_bytes(T);
+    std::vector<uint64_t> part_start(T + 1, 0);
+
+    byte_offset.assign(vert_count + 1, 0);
+    arc_offset.assign(adj.offset.begin(), adj.offset.end());
+    wbytes.resize(adj.arcs.size() * weight_width);
+
+    parallelFor(T, vert_count, [&](int t, size_t lo, size_t hi) {
+        std::vector<uint8_t> &out = part_bytes[t];
+
+        auto put = [&out](uint32_t x) {
+            while (x >= 0x80) {
+                out.push_back((uint8_t)(x | 0x80));
+                x >>= 7;
+            }
+            out.push_back((uint8_t)x);
+        };
+
+        for (size_t v = lo; v < hi; ++v) {
+            auto first = adj.arcs.begin() + adj.offset[v];
+            auto last = adj.arcs.begin() + adj.offset[v + 1];
+            std::sort(first, last);
+
+            int prev = (int)v;
+            for (size_t a = adj.offset[v]; a < adj.offset[v + 1]; ++a) {
+                int d = adj.arcs[a].first - prev;
+                put(a == adj.offset[v] ? ((uint32_t)d << 1) ^ (uint32_t)(d >> 31) : (uint32_t)d);
+                prev = adj.arcs[a].first;
+
+                uint32_t w = (uint32_t)adj.arcs[a].second;
+                for (int b = 0; b < weight_width; ++b)
+                    wbytes[a * weight_width + b] = (uint8_t)(w >> (8 * b));
+            }
+            byte_offset[v + 1] = out.size();     //relative to the block for now
+        }
+    });
+
+    for (int t = 0; t < T; ++t)
+        part_start[t + 1] = part_start[t] + part_bytes[t].size();
+    bytes.resize(part_start[T]);
+
+    parallelFor(T, vert_count, [&](int t, size_t lo, size_t hi) {
+        std::copy(part_bytes[t].begin(), part_bytes[t].end(), bytes.begin() + part_start[t]);
+        for (size_t v = lo; v < hi; ++v)
+            byte_offset[v + 1] += part_start[t];
+    });
+}
+//===========================================
+// memoryBytes
+// this method returns the memory held by the graph.
+// params: none
+// return value: size in bytes.
+//===========================================
+size_t CompactGraph::memoryBytes(void) const {
+    return sizeof(*this) + bytes.capacity() + wbytes.capacity()
+         + (byte_offset.capacity() + arc_offset.capacity()) * sizeof(uint64_t);
+}
+//===========================================
+// isEdge
+// this method returns true if there is an edge from v1 to v2.
+// params: two vertices - v1, v2.
+// return value: boolean value
+//===========================================
+bool CompactGraph::isEdge(const int v1, const int v2) const {
+    return getWeight(v1, v2) >= 0;
+}
+//===========================================
+// getWeight
+// this method returns the lightest weight from v1 to v2, -1 if there
+// is no edge. The row is sorted, so decoding stops past v2.
+// params: two vertices - v1, v2.
+// return value: the weight.
+//===========================================
+int CompactGraph::getWeight(const int v1, const int v2) const {
+    if (v1 >= vert_count or v2 >= vert_count or v1 < 0 or v2 < 0)
+        throw std::invalid_argument("getWeight - Invalid Vertices");
+
+    const uint8_t *p = bytes.data() + byte_offset[v1];
+    int prev = v1;
+
+    for (uint64_t a = arc_offset[v1]; a < arc_offset[v1 + 1]; ++a) {
+        uint32_t x = readVarint(p);
+        prev += (a == arc_offset[v1]) ? ((int)(x >> 1) ^ -(int)(x & 1)) : (int)x;
+
+        if (prev == v2)
+            return weightAt(a);
+        if (prev > v2)
+            break;
+    }
+    return -1;
+}
+//===========================================
+// BFS
+// breadth first search from source into the caller's state.
+// params: source vertex, the state to fill.
+// return value: none.
+//===========================================
+void CompactGraph::BFS(const int source, BFSState &state) const {
+    if (source < 0 or source > vert_count - 1)
+        throw std::invalid_argument("BFS - source out of range");
+
+    state.color.assign(vert_count, 0);
+    state.dist.assign(vert_count, -1);
+    state.pred.assign(vert_count, -1);
+    state.queue.clear();
+    state.queue.reserve(vert_count);
+
+    state.color[source] = 1;
+    state.dist[source] = 0;
+    state.queue.push_back(source);
+
+    for (size_t head = 0; head < state.queue.size(); ++head) {
+        int u = state.queue[head];
+
+        forEachNeighbor(u, [&](int v, int) {
+            if (state.color[v] == 0) {
+                state.color[v] = 1;
+                state.dist[v] = state.dist[u] + 1;
+                state.pred[v] = u;
+                state.queue.push_back(v);
+            }
+        });
+        state.color[u] = 2;
+    }
+}
+//===========================================
+// isConnected
+// this method returns true if the BFS of state reached every vertex.
+// params: the state of a previous BFS.
+// return value: boolean value.
+//===========================================
+bool CompactGraph::isConnected(const BFSState &state) const {
+    if ((int)state.color.size() != vert_count)
+        throw std::runtime_error("isConnected - Invalid State");
+
+    if (vert_count == 0)
+        return false;
+
+    for (int i = 0; i < vert_count; ++i) {
+        if (state.color[i] == 0)
+            return false;
+    }
+    return true;
+}
+//===========================================
+// DFS
+// depth first search into the caller's state, with an explicit
+// stack of (vertex, next arc). Each vertex is on the stack at most
+// once, so where its decoding stopped is kept per vertex.
+// params: the state to fill.
+// return value: none.
+//===========================================
+void CompactGraph::DFS(DFSState &state) const {
+    state.color.assign(vert_count, 0);
+    state.pred.assign(vert_count, -1);
+    state.disc.assign(vert_count, -1);
+    state.f.assign(vert_count, -1);
+    state.edges.clear();
+    state.stack.clear();
+
+    std::vector<uint64_t> pos(vert_count);  //next byte to decode
+    std::vector<int> prev(vert_count);      //last neighbor decoded
+
+    auto open = [&](int v, int &clock) {
+        state.disc[v] = ++clock;
+        state.color[v] = 1;
+        pos[v] = byte_offset[v];
+        prev[v] = v;
+        state.stack.emplace_back(v, arc_offset[v]);
+    };
+
+    int clock = 0;
+    for (int s = 0; s < vert_count; ++s) {
+        if (state.color[s] != 0)
+            continue;
+
+        open(s, clock);
+
+        while (!state.stack.empty()) {
+            int u = state.stack.back().first;
+            size_t a = state.stack.back().second;
+
+            if (a == arc_offset[u + 1]) {
+                state.f[u] = ++clock;
+                state.color[u] = 2;
+                state.stack.pop_back();
+                continue;
+            }
+
+            const uint8_t *p = bytes.data() + pos[u];
+            uint32_t x = readVarint(p);
+            prev[u] += (a == arc_offset[u]) ? ((int)(x >> 1) ^ -(int)(x & 1)) : (int)x;
+            pos[u] = p - bytes.data();
+            state.stack.back().second = a + 1;
+
+            int v = prev[u];
+            state.edges.emplace_back(u, v);
+
+            if (state.color[v] == 0) {
+                state.pred[v] = u;
+                open(v, clock);
+            }
+        }
+    }
+}
+//===========================================
+// MST_Prim
+// Prim's algorithm grown from root, with the bucket queue when the
+// weights are small (as SparseGraph::MST_Prim).
+// params: the root vertex.
+// return value: pointer to the MST (owned by the caller).
+//===========================================
+SparseGraph* CompactGraph::MST_Prim(const int root) const {
+    SparseGraph* mst_graph = new SparseGraph(vert_count, 0);
+
+    auto forEach = [this](int u, auto f) { forEachNeighbor(u, f); };
+
+    try {
+        if (max_weight < BUCKET_PRIM_MAX_WEIGHT)
+            primBucket(vert_count, max_weight, root, forEach, *mst_graph);
+        else
+            primHeap(vert_count, root, forEach, *mst_graph);
+    }
+    catch (...) {
+        delete mst_graph;
+        throw;
+    }
+    return mst_graph;
+}
+//===========================================
+// MST_Kruskal
+// Kruskal's algorithm over every edge.
+// params: none.
+// return value: pointer to the MST (owned by the caller).
+//===========================================
+SparseGraph* CompactGraph::MST_Kruskal(void) const {
+    SparseGraph* mst_graph = new SparseGraph(vert_count, 0);
+
+    kruskal(vert_count, [this](int u, auto f) { forEachNeighbor(u, f); }, *mst_graph);
+    return mst_graph;
+}
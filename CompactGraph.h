@@ -0,0 +1,98 @@
+//================================================================
+// CompactGraph.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the CompactGraph class, a read-only
+// adjacency format for very large sparse graphs. The neighbors of each
+// vertex are sorted and stored as gaps in a varint (LEB128) byte
+// stream; the weights are stored apart with the smallest fixed width
+// (1, 2 or 4 bytes) that holds the largest weight. Like GraphView, the
+// graph is frozen after construction and the queries are const with
+// caller-owned state.
+//================================================================
+
+#include "Graph.h"
+#include "GraphView.h"
+#include "SparseGraph.h"
+#include "ParallelBuild.h"
+#include <vector>
+#include <tuple>
+#include <cstdint>
+
+#ifndef COMPACTGRAPH_H
+#define COMPACTGRAPH_H
+
+class CompactGraph {
+    private:
+        int vert_count;
+        int edge_count;
+        int max_weight;
+        int weight_width;               //bytes per weight
+
+        std::vector<uint64_t> byte_offset;  //neighbor bytes of v start here
+        std::vector<uint64_t> arc_offset;   //weights of v start at this arc
+        std::vector<uint8_t> bytes;         //varint gaps of the sorted neighbors
+        std::vector<uint8_t> wbytes;        //weights, weight_width bytes each
+
+        void encode(Adjacency &adj, const int threads);
+
+        static uint32_t readVarint(const uint8_t *&p) {
+            uint32_t x = *p++;
+            if (x < 0x80)
+                return x;
+            x &= 0x7f;
+            for (int shift = 7; ; shift += 7) {
+                uint32_t b = *p++;
+                x |= (b & 0x7f) << shift;
+                if (b < 0x80)
+                    return x;
+            }
+        }
+        int weightAt(const uint64_t arc) const {
+            const uint8_t *p = wbytes.data() + arc * weight_width;
+            if (weight_width == 1)
+                return p[0];
+            if (weight_width == 2)
+                return p[0] | (p[1] << 8);
+            return (int)((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24));
+        }
+    public:
+        explicit CompactGraph(const Graph &g);
+        CompactGraph(const int V, const std::vector<std::tuple<int, int, int>> &edge_list, const int threads = 1);
+        CompactGraph(const int V, const int E, std::istream &is, const int threads);
+
+        int size(void) const { return vert_count; }
+        int numEdges(void) const { return edge_count; }
+        int maxWeight(void) const { return max_weight; }
+        int degree(const int v) const { return (int)(arc_offset[v + 1] - arc_offset[v]); }
+        size_t memoryBytes(void) const;
+
+        //Calls f(neighbor, weight) for every edge of v, by increasing neighbor
+        template <class F>
+        void forEachNeighbor(const int v, F f) const {
+            const uint8_t *p = bytes.data() + byte_offset[v];
+            uint64_t end = arc_offset[v + 1];
+            int prev = v;
+
+            for (uint64_t a = arc_offset[v]; a < end; ++a) {
+                uint32_t x = readVarint(p);
+                if (a == arc_offset[v])     //first one is zigzag coded from v
+                    prev += (int)(x >> 1) ^ -(int)(x & 1);
+                else
+                    prev += (int)x;
+                f(prev, weightAt(a));
+            }
+        }
+
+        bool    isEdge      (const int v1, const int v2) const;
+        int     getWeight   (const int v1, const int v2) const;
+
+        void    BFS         (const int source, BFSState &state) const;
+        bool    isConnected (const BFSState &state) const;
+        void    DFS         (DFSState &state) const;
+
+        SparseGraph*    MST_Prim    (const int root = 0) const;
+        SparseGraph*    MST_Kruskal (void) const;
+};
+
+#endif
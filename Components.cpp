@@ -0,0 +1,178 @@
+//================================================================
+// Components.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the Components.cpp file that implements the components
+// engine. The sequential versions feed every edge to an ArrayDSU.
+// The parallel version splits the vertices between the threads, which
+// union their arcs into one shared parent array of atomics:
+//     find   follows parents, halving the path with a compare-exchange
+//     union  links the larger root under the smaller one, only if it
+//            is still a root (compare-exchange), or retries
+// A root always points to a smaller index, so no cycle can form, and
+// a failed compare-exchange only means another thread got there first.
+//================================================================
+
+#include "Components.h"
+#include "Parallel.h"
+#include <atomic>
+#include <memory>
+#include <tuple>
+
+namespace {
+
+//===========================================
+// numberLabels
+// this method turns the roots of the vertices into labels numbered by
+// smallest vertex, and counts the sizes.
+// params: root of each vertex, the result (output)
+// return value: none.
+//===========================================
+void numberLabels(const std::vector<int> &root, ComponentsResult &result) {
+    const int V = (int)root.size();
+    std::vector<int> id(V, -1);
+
+    result.label.resize(V);
+    result.size.clear();
+    for (int v = 0; v < V; ++v) {
+        int &c = id[root[v]];
+        if (c == -1) {
+            c = (int)result.size.size();
+            result.size.push_back(0);
+        }
+        result.label[v] = c;
+        result.size[c]++;
+    }
+}
+
+//===========================================
+// findRoot
+// this method finds the root of v in the shared parent array.
+// params: the parent array, the vertex
+// return value: the root.
+//===========================================
+int findRoot(std::atomic<int> *parent, int v) {
+    while (true) {
+        int p = parent[v].load(std::memory_order_relaxed);
+        if (p == v)
+            return v;
+
+        int gp = parent[p].load(std::memory_order_relaxed);
+        if (gp != p)
+            parent[v].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+        v = gp;
+    }
+}
+
+//===========================================
+// unite
+// this method merges the sets of a and b in the shared parent array.
+// params: the parent array, two vertices
+// return value: none.
+//===========================================
+void unite(std::atomic<int> *parent, int a, int b) {
+    while (true) {
+        a = findRoot(parent, a);
+        b = findRoot(parent, b);
+        if (a == b)
+            return;
+        if (a < b)
+            std::swap(a, b);
+
+        int expected = a;
+        if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed))
+            return;
+    }
+}
+
+}
+
+//===========================================
+// largest
+// this method returns the component with the most vertices.
+// params: none
+// return value: the label, -1 if there is no vertex.
+//===========================================
+int ComponentsResult::largest(void) const {
+    int best = -1;
+
+    for (int c = 0; c < count(); ++c) {
+        if (best == -1 or size[c] > size[best])
+            best = c;
+    }
+    return best;
+}
+//===========================================
+// components
+// this method labels the components from the edge set of g.
+// params: Graph &g, the result (output)
+// return value: none.
+//===========================================
+void components(const Graph &g, ComponentsResult &result) {
+    const int V = g.size();
+    ArrayDSU S(V);
+    std::vector<int> root(V);
+
+    for (const auto& e : g.getEdges())
+        S.union_(std::get<0>(e), std::get<1>(e));
+    for (int v = 0; v < V; ++v)
+        root[v] = S.find_(v);
+    numberLabels(root, result);
+}
+//===========================================
+// components
+// this method labels the components from the arcs of the view, on
+// threads threads. Undirected arcs are stored both ways, so only the
+// ones going up are needed.
+// params: the view, the result (output), thread count
+// return value: none.
+//===========================================
+void components(const GraphView &view, ComponentsResult &result, const int threads) {
+    const int V = view.size();
+    std::vector<int> root(V);
+
+    auto keep = [](const int v, const int t) {
+        #ifdef DIRECTED_GRAPH
+        return t != v;
+        #else
+        return t > v;
+        #endif
+    };
+
+    if (threads <= 1) {
+        ArrayDSU S(V);
+
+        for (int v = 0; v < V; ++v) {
+            const int *t = view.targets(v);
+            for (int a = 0, d = view.degree(v); a < d; ++a) {
+                if (keep(v, t[a]))
+                    S.union_(v, t[a]);
+            }
+        }
+        for (int v = 0; v < V; ++v)
+            root[v] = S.find_(v);
+        numberLabels(root, result);
+        return;
+    }
+
+    std::unique_ptr<std::atomic<int>[]> parent(new std::atomic<int>[V]);
+
+    parallelFor(threads, V, [&](int, size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; ++v)
+            parent[v].store((int)v, std::memory_order_relaxed);
+    });
+    parallelFor(threads, V, [&](int, size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; ++v) {
+            const int *t = view.targets((int)v);
+            for (int a = 0, d = view.degree((int)v); a < d; ++a) {
+                if (keep((int)v, t[a]))
+                    unite(parent.get(), (int)v, t[a]);
+            }
+        }
+    });
+    parallelFor(threads, V, [&](int, size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; ++v)
+            root[v] = findRoot(parent.get(), (int)v);
+    });
+    numberLabels(root, result);
+}
@@ -0,0 +1,37 @@
+//================================================================
+// Components.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the connected components engine.
+// Unlike Graph::isConnected, it needs no BFS beforehand and does not
+// touch the table: every call returns its own labels. Labels are
+// numbered 0 .. count - 1 in the order of the smallest vertex of each
+// component, so every method gives the same labels for a graph.
+// With DIRECTED_GRAPH the components are the weakly connected ones.
+//================================================================
+
+#include "Graph.h"
+#include "GraphView.h"
+#include <vector>
+
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+struct ComponentsResult {
+    std::vector<int> label;     //component of each vertex
+    std::vector<int> size;      //vertices of each component
+
+    int     count       (void) const { return (int)size.size(); }
+    bool    connected   (void) const { return size.size() == 1; }
+    bool    same        (const int v1, const int v2) const { return label[v1] == label[v2]; }
+    //Component with the most vertices (the first one on ties), -1 if none
+    int     largest     (void) const;
+};
+
+//Union-find over the edge set, for any backend (and MST results)
+void components(const Graph &g, ComponentsResult &result);
+//Union-find over the arcs of the view; with several threads the
+//unions are done concurrently on a lock-free parent array
+void components(const GraphView &view, ComponentsResult &result, const int threads = 1);
+
+#endif
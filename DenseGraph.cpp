@@ -13,6 +13,8 @@
 //================================================================
 
 #include "DenseGraph.h"
+#include "Parallel.h"
+#include <algorithm>
 
 //===========================================
 // Default constructor
@@ -40,7 +42,9 @@ DenseGraph::DenseGraph(const int V, const int E) : \
 //===========================================
 
 DenseGraph::DenseGraph(const DenseGraph &other) : \
-    Graph(other.vert_count, other.edge_count), matrix(other.matrix) {}
+    Graph(other.vert_count, other.edge_count), matrix(other.matrix) {
+    max_weight = other.max_weight;
+}
 
 //===========================================
 // assignment operator
@@ -53,6 +57,7 @@ DenseGraph& DenseGraph::operator=(const DenseGraph &other) {
     if (this != &other) {
         vert_count = other.vert_count;
         edge_count = other.edge_count;
+        max_weight = other.max_weight;
         matrix = other.matrix;
     }
     return *this;
@@ -83,6 +88,22 @@ int DenseGraph::getWeight(const int v1, const int v2) const {
     if (!isEdge(v1,v2)) return -1;
 
     return matrix[v1][v2];
+}
+//===========================================
+// getNeighbors
+// this method lists the edges in the row of v, by increasing neighbor.
+// params: vertex v, the vector receiving the (neighbor, weight) pairs.
+// return value: none.
+//===========================================
+void DenseGraph::getNeighbors(const int v, std::vector<std::pair<int,int>> &out) const {
+    if (v >= vert_count or v < 0)
+        throw std::invalid_argument("getNeighbors - Invalid Vertex");
+
+    out.clear();
+    for (int i = 0; i < vert_count; ++i) {
+        if (matrix[v][i] >= 0)
+            out.emplace_back(i, matrix[v][i]);
+    }
 }
  //===========================================
 // insertEdge
@@ -100,6 +121,7 @@ void DenseGraph::insertEdge(const int v1, const int v2, int w) {
 
     if (matrix[v1][v2] == -1) {
         matrix[v1][v2] = w;
+        max_weight = std::max(max_weight, w);
         edges.insert(std::make_tuple(v1, v2, w));
 
         #ifndef DIRECTED_GRAPH
@@ -237,34 +259,149 @@ DenseGraph* DenseGraph::MST_Prim() {
     return mst_graph;
 }
 
+//===========================================
+// MST_Kruskal
+// Kruskal on one thread; computeMST passes on the threads it is given.
+// params: none.
+// return value: pointer to the MST (owned by the caller).
+//===========================================
 DenseGraph* DenseGraph::MST_Kruskal(void) {
-    DenseGraph* mst_graph = new DenseGraph(vert_count, 0);
+    return MST_Kruskal(1);
+}
+//===========================================
+// MST_Kruskal
+// Kruskal over the edges taken from the upper triangle of the matrix
+// (the whole matrix with DIRECTED_GRAPH), each once. The rows are
+// split into one block per thread with about the same number of
+// cells, and each thread sweeps its rows left to right. With weights
+// below DENSE_COUNTING_MAX_WEIGHT the edges are placed by a counting
+// sort: one sweep counts the weights, a second writes every (v1, v2)
+// straight into its slot, so no weight is stored and nothing is
+// compared. Otherwise the lightest edges are split off with
+// nth_element and sorted, and the others only if the tree needs them.
+// params: thread count.
+// return value: pointer to the MST (owned by the caller).
+//===========================================
+DenseGraph* DenseGraph::MST_Kruskal(const int threads) {
+    const int V = vert_count;
+    const int T = std::max(1, std::min(threads, V));
+    DenseGraph* mst_graph = new DenseGraph(V, 0);
+
+    //columns of row i that hold an edge not seen from another row
+    auto first = [](const int i) {
+        #ifdef DIRECTED_GRAPH
+        return 0;
+        #else
+        return i + 1;
+        #endif
+    };
+    //rows [block[t], block[t + 1]) go to thread t
+    std::vector<int> block(T + 1, V);
+    {
+        double cells = 0;
+        for (int i = 0; i < V; ++i)
+            cells += V - first(i);
+        double done = 0;
+        int t = 0;
+        block[0] = 0;
+        for (int i = 0; i < V and t + 1 < T; ++i) {
+            done += V - first(i);
+            if (done >= cells * (t + 1) / T)
+                block[++t] = i + 1;
+        }
+    }
 
-    std::priority_queue<std::tuple<int, int, int>, std::vector<std::tuple<int, int, int>>, sortbythird> pq;
+    ArrayDSU S(V);
+    int found = 0;
+    auto take = [&](const int v1, const int v2, const int w) {
+        if (found < V - 1 and S.union_(v1, v2)) {
+            mst_graph->insertTreeEdge(v1, v2, w);
+            ++found;
+        }
+    };
+
+    //a bucket per weight only pays off if there are more cells than weights
+    if (max_weight < DENSE_COUNTING_MAX_WEIGHT and max_weight <= (long long)V * V) {
+        const int W = max_weight + 1;
+        std::vector<std::vector<size_t>> slot(T, std::vector<size_t>(W, 0));
+
+        parallelFor(T, T, [&](int, size_t lo, size_t hi) {
+            for (size_t t = lo; t < hi; ++t) {
+                std::vector<size_t> &count = slot[t];
+                for (int i = block[t]; i < block[t + 1]; ++i) {
+                    const int *row = matrix[i].data();
+                    for (int j = first(i); j < V; ++j) {
+                        if (row[j] >= 0 and j != i)
+                            count[row[j]]++;
+                    }
+                }
+            }
+        });
+
+        //weight by weight, thread by thread: equal weights stay in row order
+        std::vector<size_t> bucket(W + 1, 0);
+        size_t total = 0;
+        for (int w = 0; w < W; ++w) {
+            bucket[w] = total;
+            for (int t = 0; t < T; ++t) {
+                size_t n = slot[t][w];
+                slot[t][w] = total;
+                total += n;
+            }
+        }
+        bucket[W] = total;
+
+        std::vector<std::pair<int, int>> pairs(total);
+        parallelFor(T, T, [&](int, size_t lo, size_t hi) {
+            for (size_t t = lo; t < hi; ++t) {
+                std::vector<size_t> &next = slot[t];
+                for (int i = block[t]; i < block[t + 1]; ++i) {
+                    const int *row = matrix[i].data();
+                    for (int j = first(i); j < V; ++j) {
+                        if (row[j] >= 0 and j != i)
+                            pairs[next[row[j]]++] = std::make_pair(i, j);
+                    }
+                }
+            }
+        });
 
-    for (int i = 0; i < vert_count; ++i) {
-        for (int j = 0; j < vert_count; ++j) {
-            if (isEdge(i, j))
-                pq.push(std::make_tuple(i, j, matrix[i][j]));
+        for (int w = 0; w < W and found < V - 1; ++w) {
+            for (size_t k = bucket[w]; k < bucket[w + 1]; ++k)
+                take(pairs[k].first, pairs[k].second, w);
         }
+        return mst_graph;
     }
-    DSU S(vert_count);
-    int count = 1;
 
-    while (!pq.empty() && count < vert_count) {
-        auto uvw = pq.top();
-        pq.pop();
+    //(w, v1, v2): ordered by weight, then by position in the matrix
+    std::vector<std::vector<std::tuple<int, int, int>>> part(T);
+    parallelFor(T, T, [&](int, size_t lo, size_t hi) {
+        for (size_t t = lo; t < hi; ++t) {
+            for (int i = block[t]; i < block[t + 1]; ++i) {
+                const int *row = matrix[i].data();
+                for (int j = first(i); j < V; ++j) {
+                    if (row[j] >= 0 and j != i)
+                        part[t].emplace_back(row[j], i, j);
+                }
+            }
+        }
+    });
 
-        int u = std::get<0>(uvw);
-        int v = std::get<1>(uvw);
-        int w = std::get<2>(uvw);
+    std::vector<std::tuple<int, int, int>> sorted = std::move(part[0]);
+    for (int t = 1; t < T; ++t) {
+        sorted.insert(sorted.end(), part[t].begin(), part[t].end());
+        std::vector<std::tuple<int, int, int>>().swap(part[t]);
+    }
 
-        if (S.find_(u) != S.find_(v)) {
-            mst_graph->edges.insert(uvw);
-            mst_graph->edge_count++;
-            S.union_(u, v);
-            ++count;
-        }
+    //the tree is usually done within the lightest few edges per vertex:
+    //sort those first, and the rest only if they are needed
+    size_t light = std::min(sorted.size(), (size_t)V * DENSE_KRUSKAL_LIGHT_EDGES);
+    std::nth_element(sorted.begin(), sorted.begin() + light, sorted.end());
+    std::sort(sorted.begin(), sorted.begin() + light);
+
+    for (size_t k = 0; k < sorted.size() and found < V - 1; ++k) {
+        if (k == light)
+            std::sort(sorted.begin() + light, sorted.end());
+        take(std::get<1>(sorted[k]), std::get<2>(sorted[k]), std::get<0>(sorted[k]));
     }
     return mst_graph;
 }
\ No newline at end of file
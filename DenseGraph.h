@@ -14,6 +14,14 @@
 #ifndef DENSEGRAPH_H
 #define DENSEGRAPH_H
 
+//From this many vertices computeMST lets Kruskal extract the edges on
+//several threads
+const int DENSE_PARALLEL_VERTICES = 2048;
+//Below this weight Kruskal buckets the edges by a counting sort
+const int DENSE_COUNTING_MAX_WEIGHT = 1 << 16;
+//Above it, Kruskal sorts this many lightest edges per vertex first
+const int DENSE_KRUSKAL_LIGHT_EDGES = 8;
+
 class DenseGraph : public Graph {
     private:
         std::vector<std::vector<int>> matrix;
@@ -27,6 +35,7 @@ class DenseGraph : public Graph {
         void insertEdge(const int v1, const int v2, int w) override; //insertEdge
         bool isEdge(const int v1, const int v2) const override; // isEdge
         int getWeight(const int v1, const int v2) const override; //getWeight
+        void getNeighbors(const int v, std::vector<std::pair<int,int>> &out) const override; //row of v
 
         //BFS-based Algorithms
         void BFS(int source) override; // breadth first search
@@ -38,6 +47,7 @@ class DenseGraph : public Graph {
        // project 7 algorithms 
         DenseGraph*    MST_Prim (void) override;
         DenseGraph*    MST_Kruskal (void) override;
+        DenseGraph*    MST_Kruskal (const int threads);
 };
 
 #endif
\ No newline at end of file
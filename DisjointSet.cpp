@@ -59,4 +59,46 @@ void DSU::union_(int a, int b) {
     }
     root_a->node_head->size += root_b->node_head->size;
     root_a->node_head->set_tail = last;
-}
\ No newline at end of file
+}
+
+ArrayDSU::ArrayDSU(int n) {
+    if (n < 0)
+        throw std::invalid_argument("ArrayDSU constructor - Invalid Size");
+
+    parent.resize(n);
+    set_size.assign(n, 1);
+    for (int i=0; i < n; ++i)
+        parent[i] = i;
+}
+
+int ArrayDSU::find_(int index) {
+    /*
+    Runtime Complexity: O(alpha(n)) amortized, with union by size
+    */
+    if (index < 0 || index >= (int)parent.size())
+        throw std::invalid_argument("ArrayDSU find - Invalid Index");
+
+    while (parent[index] != index) {
+        parent[index] = parent[parent[index]];     // path halving
+        index = parent[index];
+    }
+    return index;
+}
+
+bool ArrayDSU::union_(int a, int b) {
+    /*
+    Runtime Complexity: O(alpha(n)) amortized
+    */
+    a = find_(a);
+    b = find_(b);
+
+    if (a == b)
+        return false;
+
+    if (set_size[a] < set_size[b])
+        std::swap(a, b);
+
+    parent[b] = a;
+    set_size[a] += set_size[b];
+    return true;
+}
@@ -34,4 +34,20 @@ class DSU {
         void union_(int a, int b);
 };
 
+//Disjoint sets in two flat arrays (parent and size), with union by
+//size and path halving, for the algorithms that do millions of finds.
+class ArrayDSU {
+    private:
+        std::vector<int> parent;
+        std::vector<int> set_size;     //valid for roots only
+    public:
+        ArrayDSU(int n);
+        ~ArrayDSU(void) {}
+
+        int find_(int index);
+        bool union_(int a, int b);      //false if a and b were already together
+        int size_(int index) { return set_size[find_(index)]; }
+        int count(void) const { return (int)parent.size(); }
+};
+
 #endif
\ No newline at end of file
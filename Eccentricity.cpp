@@ -0,0 +1,340 @@
+//================================================================
+// Eccentricity.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the Eccentricity.cpp file that implements the eccentricity
+// engine. Everything rests on two facts of undirected distances: for
+// any v and w of a component, with d = dist(v, w),
+//     max(d, ecc(v) - d) <= ecc(w) <= ecc(v) + d
+// and ecc(v) <= diameter <= 2 ecc(v). A BFS from v therefore bounds
+// the eccentricity of its whole component. With DIRECTED_GRAPH the
+// bounds do not hold, and every vertex is measured with the batched
+// BFS instead.
+// The BFS used here only touches the component of its source, so a
+// graph of many small components costs O(V + E) in total.
+//================================================================
+
+#include "Eccentricity.h"
+#include "MultiSourceBFS.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+//The bounding stops once the last BOUNDING_WINDOW runs have closed fewer
+//than BOUNDING_MIN_GAIN vertices each: a batch of 64 sources in the
+//multi-source BFS costs a few single runs, so it is then cheaper.
+const int BOUNDING_WINDOW = 16;
+const int BOUNDING_MIN_GAIN = 16;
+
+//BFS that only resets the vertices it reached
+class Sweeper {
+    private:
+        const GraphView &view;
+    public:
+        std::vector<int> dist;      //-1 outside the last BFS
+        std::vector<int> pred;
+        std::vector<int> queue;     //vertices of the last BFS, by distance
+        int runs;
+
+        explicit Sweeper(const GraphView &g) : view(g), dist(g.size(), -1), pred(g.size(), -1), runs(0) {}
+
+        //===========================================
+        // run
+        // this method runs a BFS from s.
+        // params: the source
+        // return value: the eccentricity of s.
+        //===========================================
+        int run(const int s) {
+            for (int v : queue)
+                dist[v] = -1;
+            queue.clear();
+
+            dist[s] = 0;
+            pred[s] = -1;
+            queue.push_back(s);
+            for (size_t head = 0; head < queue.size(); ++head) {
+                int u = queue[head];
+                const int *t = view.targets(u);
+
+                for (int a = 0, d = view.degree(u); a < d; ++a) {
+                    if (dist[t[a]] == -1) {
+                        dist[t[a]] = dist[u] + 1;
+                        pred[t[a]] = u;
+                        queue.push_back(t[a]);
+                    }
+                }
+            }
+            ++runs;
+            return dist[queue.back()];
+        }
+
+        int farthest(void) const { return queue.back(); }
+
+        //vertex halfway on the BFS path from the source to v
+        int middle(int v) const {
+            for (int steps = dist[v] / 2; steps > 0; --steps)
+                v = pred[v];
+            return v;
+        }
+};
+
+//Keeps the larger lower bound of a result, with its end points
+void raiseLower(DiameterResult &r, const int lower, const int from, const int to) {
+    if (lower > r.lower or r.from == -1) {
+        r.lower = lower;
+        r.from = from;
+        r.to = to;
+    }
+}
+
+//===========================================
+// fourSweep
+// this method bounds the diameter of the component of r with four
+// BFS: two double sweeps, the second one started from the middle of
+// the path the first one found.
+// params: the sweeper, a vertex of the component, the bounds (output)
+// return value: none.
+//===========================================
+void fourSweep(Sweeper &sw, const int r, DiameterResult &bounds) {
+    int e = sw.run(r);
+    int a = sw.farthest();
+    bounds.upper = 2 * e;
+    raiseLower(bounds, e, r, a);
+
+    e = sw.run(a);
+    raiseLower(bounds, e, a, sw.farthest());
+    int m = sw.middle(sw.farthest());
+
+    e = sw.run(m);
+    bounds.upper = std::min(bounds.upper, 2 * e);
+    a = sw.farthest();
+
+    e = sw.run(a);
+    raiseLower(bounds, e, a, sw.farthest());
+    int u = sw.middle(sw.farthest());
+
+    e = sw.run(u);
+    bounds.upper = std::min(bounds.upper, 2 * e);
+}
+
+//===========================================
+// bounding
+// this method runs the bounding loop over the open vertices. The next
+// source alternates between the open vertex with the smallest lower
+// bound and the one with the largest upper bound (the highest degree
+// on ties); each BFS tightens both bounds of its component and settles
+// the vertices whose bounds meet. For the diameter alone (diam given),
+// a vertex is also dropped once its upper bound is no more than the
+// largest eccentricity found, since it cannot raise the diameter.
+// The loop ends when nothing is open, after budget runs, or when the
+// runs stop paying off (see BOUNDING_MIN_GAIN).
+// params: the view, the sweeper, eccentricities (-1: unknown), the
+//         open vertices (updated), BFS budget, the diameter (or null)
+// return value: none.
+//===========================================
+void bounding(const GraphView &view, Sweeper &sw, std::vector<int> &ecc, std::vector<int> &open,
+              const int budget, DiameterResult *diam) {
+    const int V = view.size();
+    std::vector<int> lower(V, 0);
+    std::vector<int> upper(V, std::numeric_limits<int>::max());
+    bool by_upper = false;
+    std::vector<size_t> open_before;    //open.size() before each run
+
+    while (!open.empty() and sw.runs < budget) {
+        size_t k = open_before.size();
+        if (k >= BOUNDING_WINDOW and
+            open_before[k - BOUNDING_WINDOW] - open.size() < (size_t)BOUNDING_WINDOW * BOUNDING_MIN_GAIN)
+            break;
+        open_before.push_back(open.size());
+
+        int v = open[0];
+        for (int w : open) {
+            long long key_w = by_upper ? upper[w] : -(long long)lower[w];
+            long long key_v = by_upper ? upper[v] : -(long long)lower[v];
+            if (key_w > key_v or (key_w == key_v and view.degree(w) > view.degree(v)))
+                v = w;
+        }
+        by_upper = !by_upper;
+
+        int e = sw.run(v);
+        for (int w : sw.queue) {
+            int d = sw.dist[w];
+            lower[w] = std::max(lower[w], std::max(d, e - d));
+            upper[w] = std::min(upper[w], e + d);
+            if (lower[w] == upper[w])
+                ecc[w] = lower[w];
+        }
+        ecc[v] = e;
+        if (diam)
+            raiseLower(*diam, e, v, sw.farthest());
+
+        size_t n = 0;
+        for (int w : open) {
+            if (ecc[w] < 0 and (!diam or upper[w] > diam->lower))
+                open[n++] = w;
+        }
+        open.resize(n);
+    }
+}
+
+//===========================================
+// exhaust
+// this method measures the open vertices with the batched BFS.
+// params: the view, eccentricities (filled in), the open vertices,
+//         thread count
+// return value: none.
+//===========================================
+void exhaust(const GraphView &view, std::vector<int> &ecc, const std::vector<int> &open, const int threads) {
+    MultiBFSResult r;
+
+    multiSourceBFS(view, open, r, false, threads);
+    for (size_t i = 0; i < open.size(); ++i)
+        ecc[open[i]] = r.eccentricity[i];
+}
+
+}
+
+//===========================================
+// periphery
+// this method lists the vertices whose eccentricity is the diameter.
+// params: none
+// return value: the vertices.
+//===========================================
+std::vector<int> EccentricityResult::periphery(void) const {
+    std::vector<int> out;
+
+    for (int v = 0; v < (int)eccentricity.size(); ++v) {
+        if (eccentricity[v] == diameter)
+            out.push_back(v);
+    }
+    return out;
+}
+//===========================================
+// center
+// this method lists the vertices whose eccentricity is the radius.
+// params: none
+// return value: the vertices.
+//===========================================
+std::vector<int> EccentricityResult::center(void) const {
+    std::vector<int> out;
+
+    for (int v = 0; v < (int)eccentricity.size(); ++v) {
+        if (eccentricity[v] == radius)
+            out.push_back(v);
+    }
+    return out;
+}
+//===========================================
+// estimateDiameter
+// this method bounds the diameter with four sweeps per component.
+// With DIRECTED_GRAPH the sweeps give no bounds and it is exact.
+// params: the view
+// return value: the bounds, often already equal.
+//===========================================
+DiameterResult estimateDiameter(const GraphView &view) {
+    DiameterResult best;
+
+    #ifdef DIRECTED_GRAPH
+    best = exactDiameter(view);
+    #else
+    Sweeper sw(view);
+    std::vector<char> done(view.size(), 0);
+
+    for (int r = 0; r < view.size(); ++r) {
+        if (done[r])
+            continue;
+
+        DiameterResult comp;
+        fourSweep(sw, r, comp);
+        for (int v : sw.queue)
+            done[v] = 1;
+
+        raiseLower(best, comp.lower, comp.from, comp.to);
+        best.upper = std::max(best.upper, comp.upper);
+    }
+    best.bfs_runs = sw.runs;
+    #endif
+    return best;
+}
+//===========================================
+// exactDiameter
+// this method finds the diameter with the bounding loop, starting from
+// the lower bound of one double sweep. Vertices still open after
+// max_bfs runs are measured by the batched BFS.
+// params: the view, BFS budget, thread count
+// return value: the diameter (lower == upper).
+//===========================================
+DiameterResult exactDiameter(const GraphView &view, const int max_bfs, const int threads) {
+    const int V = view.size();
+    const int budget = (max_bfs > 0) ? max_bfs : std::max(64, V / 16);
+    DiameterResult best;
+    std::vector<int> ecc(V, -1);
+    std::vector<int> open(V);
+
+    for (int v = 0; v < V; ++v)
+        open[v] = v;
+
+    #ifndef DIRECTED_GRAPH
+    Sweeper sw(view);
+    if (V > 0) {
+        sw.run(0);
+        int a = sw.farthest();
+        int e = sw.run(a);
+        raiseLower(best, e, a, sw.farthest());
+    }
+    bounding(view, sw, ecc, open, budget, &best);
+    best.bfs_runs = sw.runs;
+    #endif
+
+    if (!open.empty()) {
+        exhaust(view, ecc, open, threads);
+        for (int v : open) {
+            if (ecc[v] > best.lower or best.from == -1) {
+                best.lower = ecc[v];
+                best.from = v;
+                best.to = -1;
+            }
+        }
+    }
+    if (best.to == -1 and best.from != -1) {
+        Sweeper far(view);
+        far.run(best.from);
+        best.to = far.farthest();
+    }
+    best.upper = best.lower;
+    return best;
+}
+//===========================================
+// eccentricities
+// this method finds every eccentricity with the bounding loop.
+// Vertices still open after it are measured by the batched BFS.
+// params: the view, the result (output), BFS budget, thread count
+// return value: none.
+//===========================================
+void eccentricities(const GraphView &view, EccentricityResult &result, const int max_bfs, const int threads) {
+    const int V = view.size();
+    const int budget = (max_bfs > 0) ? max_bfs : std::max(64, V / 16);
+    std::vector<int> open(V);
+
+    result = EccentricityResult();
+    result.eccentricity.assign(V, -1);
+    for (int v = 0; v < V; ++v)
+        open[v] = v;
+
+    #ifndef DIRECTED_GRAPH
+    Sweeper sw(view);
+    bounding(view, sw, result.eccentricity, open, budget, nullptr);
+    result.bfs_runs = sw.runs;
+    #endif
+
+    if (!open.empty()) {
+        exhaust(view, result.eccentricity, open, threads);
+        result.fallback = (int)open.size();
+    }
+
+    if (V > 0) {
+        result.diameter = *std::max_element(result.eccentricity.begin(), result.eccentricity.end());
+        result.radius = *std::min_element(result.eccentricity.begin(), result.eccentricity.end());
+    }
+}
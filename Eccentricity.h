@@ -0,0 +1,54 @@
+//================================================================
+// Eccentricity.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the eccentricity engine. The
+// eccentricity of v is its largest distance to a vertex it reaches,
+// so on a disconnected graph every component is measured on its own
+// and the diameter is the largest over the components.
+//     estimateDiameter   a few BFS sweeps, giving lower/upper bounds
+//     exactDiameter      bounding, until no vertex can beat the
+//                        largest eccentricity found
+//     eccentricities     every eccentricity, by bounding: each BFS
+//                        tightens the bounds of its whole component
+// Both fall back on the batched BFS (MultiSourceBFS.h) for the vertices
+// left open after a budget of single BFS runs.
+// None of them runs a BFS from every vertex unless it has to.
+//================================================================
+
+#include "GraphView.h"
+#include <vector>
+
+#ifndef ECCENTRICITY_H
+#define ECCENTRICITY_H
+
+struct DiameterResult {
+    int lower = 0;      //the diameter is in [lower, upper]
+    int upper = 0;
+    int from = -1;      //two vertices at distance lower
+    int to = -1;
+    int bfs_runs = 0;
+
+    bool exact(void) const { return lower == upper; }
+};
+
+struct EccentricityResult {
+    std::vector<int> eccentricity;
+    int diameter = 0;
+    int radius = 0;     //smallest eccentricity, 0 if there is no vertex
+    int bfs_runs = 0;   //single-source BFS used by the bounding
+    int fallback = 0;   //vertices left to the batched BFS
+
+    //Vertices of eccentricity diameter (periphery) or radius (center)
+    std::vector<int> periphery(void) const;
+    std::vector<int> center(void) const;
+};
+
+//max_bfs bounds the single BFS runs before the rest is done in batches
+//(0: V / 16, at least 64)
+DiameterResult  estimateDiameter(const GraphView &view);
+DiameterResult  exactDiameter   (const GraphView &view, const int max_bfs = 0, const int threads = 1);
+void            eccentricities  (const GraphView &view, EccentricityResult &result,
+                                 const int max_bfs = 0, const int threads = 1);
+
+#endif
@@ -0,0 +1,116 @@
+//================================================================
+// EdgeIndex.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the EdgeIndex.cpp file that implements the edge hash table.
+// Linear probing over a power of two table kept at most half full, so
+// a lookup touches one or two cache lines whatever the degree of v1.
+//================================================================
+
+#include "EdgeIndex.h"
+
+//===========================================
+// Constructor
+// this method creates a table large enough for expected entries.
+// params: expected number of entries.
+// return value: none
+//===========================================
+EdgeIndex::EdgeIndex(const size_t expected) : count(0) {
+    size_t capacity = 16;
+    while (capacity < 2 * expected)
+        capacity <<= 1;
+
+    keys.assign(capacity, EMPTY);
+    values.assign(capacity, -1);
+}
+//===========================================
+// grow
+// this method doubles the table and reinserts every entry.
+// params: none
+// return value: none
+//===========================================
+void EdgeIndex::grow(void) {
+    std::vector<uint64_t> old_keys(2 * keys.size(), EMPTY);
+    std::vector<int> old_values(2 * values.size(), -1);
+    old_keys.swap(keys);        //keys/values are now the larger empty table
+    old_values.swap(values);
+
+    const size_t mask = keys.size() - 1;
+    for (size_t i = 0; i < old_keys.size(); ++i) {
+        if (old_keys[i] == EMPTY)
+            continue;
+
+        size_t slot = hash(old_keys[i]) & mask;
+        while (keys[slot] != EMPTY)
+            slot = (slot + 1) & mask;
+        keys[slot] = old_keys[i];
+        values[slot] = old_values[i];
+    }
+}
+//===========================================
+// insert
+// this method records the edge v1 -> v2 with weight w, unless the
+// pair is already there.
+// params: two vertices - v1, v2 and the weight value.
+// return value: none
+//===========================================
+void EdgeIndex::insert(const int v1, const int v2, const int w) {
+    if (2 * (count + 1) > keys.size())
+        grow();
+
+    const uint64_t key = pack(v1, v2);
+    const size_t mask = keys.size() - 1;
+    size_t slot = hash(key) & mask;
+
+    while (keys[slot] != EMPTY) {
+        if (keys[slot] == key)
+            return;
+        slot = (slot + 1) & mask;
+    }
+    keys[slot] = key;
+    values[slot] = w;
+    ++count;
+}
+//===========================================
+// find
+// this method looks up the edge v1 -> v2.
+// params: two vertices - v1, v2.
+// return value: the weight, -1 if there is no such edge.
+//===========================================
+int EdgeIndex::find(const int v1, const int v2) const {
+    const uint64_t key = pack(v1, v2);
+    const size_t mask = keys.size() - 1;
+    size_t slot = hash(key) & mask;
+
+    while (keys[slot] != EMPTY) {
+        if (keys[slot] == key)
+            return values[slot];
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+//===========================================
+// prefetch
+// this method asks the cpu to start loading the slot of (v1, v2), so
+// a batch of lookups can overlap their cache misses.
+// params: two vertices - v1, v2.
+// return value: none
+//===========================================
+void EdgeIndex::prefetch(const int v1, const int v2) const {
+    size_t slot = hash(pack(v1, v2)) & (keys.size() - 1);
+#if defined(__GNUC__)
+    __builtin_prefetch(&keys[slot]);
+    __builtin_prefetch(&values[slot]);
+#else
+    (void)slot;
+#endif
+}
+//===========================================
+// memoryBytes
+// this method returns the memory held by the table.
+// params: none
+// return value: size in bytes.
+//===========================================
+size_t EdgeIndex::memoryBytes(void) const {
+    return keys.capacity() * sizeof(uint64_t) + values.capacity() * sizeof(int);
+}
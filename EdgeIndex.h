@@ -0,0 +1,47 @@
+//================================================================
+// EdgeIndex.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the EdgeIndex class, an open
+// addressing hash table from a vertex pair (v1, v2) to the weight of
+// the edge v1 -> v2. It gives SparseGraph O(1) expected isEdge and
+// getWeight instead of a walk through the adjacency list of v1.
+//================================================================
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#ifndef EDGEINDEX_H
+#define EDGEINDEX_H
+
+class EdgeIndex {
+    private:
+        static constexpr uint64_t EMPTY = ~uint64_t(0);
+
+        std::vector<uint64_t> keys;     //(v1 << 32) | v2, EMPTY if free
+        std::vector<int> values;
+        size_t count;
+
+        static uint64_t pack(const int v1, const int v2) {
+            return ((uint64_t)(uint32_t)v1 << 32) | (uint32_t)v2;
+        }
+        static uint64_t hash(uint64_t x) {      //splitmix64 finalizer
+            x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+            x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+            return x ^ (x >> 31);
+        }
+        void grow(void);
+    public:
+        EdgeIndex(const size_t expected = 0);
+
+        //Keeps the first weight inserted for a pair, as the adjacency list walk does
+        void    insert  (const int v1, const int v2, const int w);
+        int     find    (const int v1, const int v2) const;    //-1 if absent
+        void    prefetch(const int v1, const int v2) const;
+
+        size_t  size        (void) const { return count; }
+        size_t  memoryBytes (void) const;
+};
+
+#endif
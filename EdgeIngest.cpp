@@ -0,0 +1,108 @@
+//================================================================
+// EdgeIngest.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the EdgeIngest.cpp file that implements the ingest stage.
+// Without it, SparseGraph keeps every parallel edge in its lists,
+// DenseGraph keeps the first one whatever its weight, and the edge set
+// keeps one tuple per distinct weight, all of which end up in the
+// Kruskal queue. After it every backend sees each edge once, with the
+// weight the MST would use anyway.
+//================================================================
+
+#include "EdgeIngest.h"
+#include <algorithm>
+#include <stdexcept>
+
+//===========================================
+// cout
+// this method prints the report of an ingest.
+// params: ostream &os, the report
+// return value: a reference to the output stream.
+//===========================================
+std::ostream& operator<<(std::ostream &os, const IngestReport &r) {
+    os << "read " << r.read << ", kept " << r.kept << ", removed " << r.removed()
+       << " (" << r.self_loops << " self-loops, " << r.parallel << " parallel)";
+    return os;
+}
+//===========================================
+// ingestEdges
+// this method reads up to E edges (stopping early at end of file, as
+// operator>> does) and normalizes them.
+// params: istream &is, vertices, edges in the header, report (output)
+// return value: the cleaned edge list.
+//===========================================
+std::vector<std::tuple<int, int, int>> ingestEdges(std::istream &is, const int V, const int E, IngestReport &report) {
+    std::vector<std::tuple<int, int, int>> edge_list;
+    edge_list.reserve(E > 0 ? E : 0);
+
+    int v1, v2, weight;
+    for (int i = 0; i < E; ++i) {
+        if (!(is >> v1 >> v2 >> weight)) {
+            if (!is.eof())
+                throw std::runtime_error("ingestEdges - Error reading edge data");
+            else
+                break;
+        }
+        edge_list.emplace_back(v1, v2, weight);
+    }
+    normalizeEdges(edge_list, V, report);
+    return edge_list;
+}
+//===========================================
+// normalizeEdges
+// this method validates the edges like insertEdge, drops self-loops,
+// writes undirected edges as (min, max) and keeps the lightest of
+// each group of parallel edges. Sorting by (v1, v2, w) puts the
+// lightest copy first in its group, so one pass of unique is enough.
+// The result is sorted by (v1, v2).
+// params: the edge list (modified), vertices, report (output)
+// return value: none.
+//===========================================
+void normalizeEdges(std::vector<std::tuple<int, int, int>> &edge_list, const int V, IngestReport &report) {
+    report = IngestReport();
+    report.read = edge_list.size();
+
+    size_t n = 0;
+    for (const auto& e : edge_list) {
+        int v1 = std::get<0>(e);
+        int v2 = std::get<1>(e);
+        int w = std::get<2>(e);
+
+        if (v1 >= V or v2 >= V or v1 < 0 or v2 < 0)
+            throw std::invalid_argument("insertEdge - Invalid Vertices");
+        if (w < 0)
+            throw std::invalid_argument("insertEdge - Invalid Weight");
+
+        if (v1 == v2) {
+            ++report.self_loops;
+            continue;
+        }
+        #ifndef DIRECTED_GRAPH
+        if (v1 > v2)
+            std::swap(v1, v2);
+        #endif
+        edge_list[n++] = std::make_tuple(v1, v2, w);
+    }
+    edge_list.resize(n);
+
+    std::sort(edge_list.begin(), edge_list.end());
+    auto last = std::unique(edge_list.begin(), edge_list.end(),
+        [](const std::tuple<int, int, int> &a, const std::tuple<int, int, int> &b) {
+            return std::get<0>(a) == std::get<0>(b) and std::get<1>(a) == std::get<1>(b);
+        });
+
+    report.parallel = edge_list.end() - last;
+    edge_list.erase(last, edge_list.end());
+    report.kept = edge_list.size();
+}
+//===========================================
+// loadEdges
+// this method inserts a cleaned edge list into a backend.
+// params: Graph &g, the edge list
+// return value: none.
+//===========================================
+void loadEdges(Graph &g, const std::vector<std::tuple<int, int, int>> &edge_list) {
+    for (const auto& e : edge_list)
+        g.insertEdge(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+}
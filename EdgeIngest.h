@@ -0,0 +1,35 @@
+//================================================================
+// EdgeIngest.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the edge ingest stage. It cleans an
+// edge list before any backend is built: self-loops are dropped,
+// undirected pairs are written (min, max), and parallel edges are
+// collapsed to their lightest weight, all in one sort of the list.
+//================================================================
+
+#include "Graph.h"
+#include <vector>
+#include <tuple>
+#include <iostream>
+
+#ifndef EDGEINGEST_H
+#define EDGEINGEST_H
+
+struct IngestReport {
+    size_t read       = 0;  //edges in the input
+    size_t self_loops = 0;  //dropped (v, v) edges
+    size_t parallel   = 0;  //dropped copies of an edge already kept
+    size_t kept       = 0;
+
+    size_t removed(void) const { return self_loops + parallel; }
+};
+
+std::ostream& operator<<(std::ostream &os, const IngestReport &r);
+
+//Reads up to E edges the way operator>> does, then normalizes them
+std::vector<std::tuple<int, int, int>> ingestEdges(std::istream &is, const int V, const int E, IngestReport &report);
+void    normalizeEdges  (std::vector<std::tuple<int, int, int>> &edge_list, const int V, IngestReport &report);
+void    loadEdges       (Graph &g, const std::vector<std::tuple<int, int, int>> &edge_list);
+
+#endif
@@ -0,0 +1,399 @@
+//================================================================
+// EuclideanMST.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the EuclideanMST.cpp file that implements the Euclidean MST.
+// Squared distances are compared throughout; the square root is taken
+// only for the edges kept. The k-d tree stores the points in tree
+// order, so a leaf is a contiguous run of coordinates, and Boruvka
+// works on tree-order indices, mapped back to the input only for the
+// edges. Boruvka breaks ties by the indices of the ends, so the edges
+// picked in one round can never close a cycle.
+//================================================================
+
+#include "EuclideanMST.h"
+#include "DisjointSet.h"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <iomanip>
+#include <stdexcept>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const double FAR = std::numeric_limits<double>::infinity();
+
+//Points in tree order, and the boxes of the nodes of the k-d tree
+struct KDTree {
+    int dim;
+    std::vector<double> point;      //point i of the tree at i * dim
+    std::vector<int> input;         //tree index -> input index
+    std::vector<int> lo, hi;        //points [lo, hi) of each node
+    std::vector<int> left, right;   //children, -1 for a leaf
+    std::vector<double> box_lo, box_hi;
+
+    //===========================================
+    // build
+    // this method makes the node of perm[lo, hi), splitting at the
+    // median of the widest side of its box.
+    // params: the points, the order being built, the range
+    // return value: the node.
+    //===========================================
+    int build(const PointSet &points, std::vector<int> &perm, const int from, const int to) {
+        int n = (int)lo.size();
+        lo.push_back(from);
+        hi.push_back(to);
+        left.push_back(-1);
+        right.push_back(-1);
+        box_lo.resize(box_lo.size() + dim, FAR);
+        box_hi.resize(box_hi.size() + dim, -FAR);
+
+        for (int i = from; i < to; ++i) {
+            for (int k = 0; k < dim; ++k) {
+                double x = points.at(perm[i], k);
+                box_lo[n * dim + k] = std::min(box_lo[n * dim + k], x);
+                box_hi[n * dim + k] = std::max(box_hi[n * dim + k], x);
+            }
+        }
+        if (to - from <= KD_LEAF_POINTS)
+            return n;
+
+        int split = 0;
+        for (int k = 1; k < dim; ++k) {
+            if (box_hi[n * dim + k] - box_lo[n * dim + k] > box_hi[n * dim + split] - box_lo[n * dim + split])
+                split = k;
+        }
+        int mid = from + (to - from) / 2;
+        std::nth_element(perm.begin() + from, perm.begin() + mid, perm.begin() + to, [&](int a, int b) {
+            return points.at(a, split) < points.at(b, split);
+        });
+
+        int l = build(points, perm, from, mid);
+        int r = build(points, perm, mid, to);
+        left[n] = l;
+        right[n] = r;
+        return n;
+    }
+
+    KDTree(const PointSet &points) : dim(points.dim) {
+        const int V = points.size();
+        input.resize(V);
+        for (int i = 0; i < V; ++i)
+            input[i] = i;
+        if (V > 0)
+            build(points, input, 0, V);
+
+        point.resize((size_t)V * dim);
+        for (int i = 0; i < V; ++i) {
+            for (int k = 0; k < dim; ++k)
+                point[(size_t)i * dim + k] = points.at(input[i], k);
+        }
+    }
+
+    int nodes(void) const { return (int)lo.size(); }
+
+    double distance(const int a, const int b) const {
+        double d = 0;
+        for (int k = 0; k < dim; ++k) {
+            double t = point[(size_t)a * dim + k] - point[(size_t)b * dim + k];
+            d += t * t;
+        }
+        return d;
+    }
+
+    //squared distance from point a to the box of node n
+    double boxDistance(const int a, const int n) const {
+        double d = 0;
+        for (int k = 0; k < dim; ++k) {
+            double x = point[(size_t)a * dim + k];
+            double t = std::max(box_lo[n * dim + k] - x, 0.0) + std::max(x - box_hi[n * dim + k], 0.0);
+            d += t * t;
+        }
+        return d;
+    }
+};
+
+//Lightest edge out of a component: squared length, then its ends.
+//Any edge beats none, even one whose squared length overflowed to FAR.
+struct Candidate {
+    double d = FAR;
+    int a = -1;
+    int b = -1;
+
+    bool beaten(const double e, int x, int y) const {
+        if (x > y)
+            std::swap(x, y);
+        if (a == -1)
+            return true;
+        if (e != d)
+            return e < d;
+        return x != a ? x < a : y < b;
+    }
+};
+
+//===========================================
+// addEdge
+// this method records an edge of the tree.
+// params: the tree, the two ends, the squared length
+// return value: none.
+//===========================================
+void addEdge(EuclideanTree &tree, const int a, const int b, const double d) {
+    double len = std::sqrt(d);
+    tree.v1.push_back(a);
+    tree.v2.push_back(b);
+    tree.length.push_back(len);
+    tree.total += len;
+}
+//===========================================
+// boruvka
+// this method runs the Boruvka rounds over the k-d tree. A node whose
+// points all belong to one component is marked with it, and skipped by
+// the queries from that component.
+// params: the points, the tree (output)
+// return value: none.
+//===========================================
+void boruvka(const PointSet &points, EuclideanTree &tree) {
+    const int V = points.size();
+    KDTree kd(points);
+    ArrayDSU S(V);
+    std::vector<int> comp(V);
+    std::vector<int> node_comp(kd.nodes());
+    std::vector<Candidate> best(V);
+    std::vector<int> stack;
+
+    while (tree.edges() < V - 1) {
+        for (int i = 0; i < V; ++i)
+            comp[i] = S.find_(i);
+        //children come after their parent, so go backwards
+        for (int n = kd.nodes() - 1; n >= 0; --n) {
+            if (kd.left[n] != -1) {
+                int l = node_comp[kd.left[n]];
+                node_comp[n] = (l == node_comp[kd.right[n]]) ? l : -1;
+                continue;
+            }
+            node_comp[n] = comp[kd.lo[n]];
+            for (int i = kd.lo[n] + 1; i < kd.hi[n]; ++i) {
+                if (comp[i] != node_comp[n]) {
+                    node_comp[n] = -1;
+                    break;
+                }
+            }
+        }
+        for (int i = 0; i < V; ++i)
+            best[i] = Candidate();
+
+        for (int p = 0; p < V; ++p) {
+            const int c = comp[p];
+            Candidate &b = best[c];
+
+            stack.assign(1, 0);
+            while (!stack.empty()) {
+                int n = stack.back();
+                stack.pop_back();
+                if (node_comp[n] == c or kd.boxDistance(p, n) > b.d)
+                    continue;
+
+                if (kd.left[n] == -1) {
+                    for (int q = kd.lo[n]; q < kd.hi[n]; ++q) {
+                        if (comp[q] == c)
+                            continue;
+                        double d = kd.distance(p, q);
+                        if (b.beaten(d, p, q)) {
+                            b.d = d;
+                            b.a = std::min(p, q);
+                            b.b = std::max(p, q);
+                        }
+                    }
+                    continue;
+                }
+                //nearer child on top of the stack
+                int l = kd.left[n], r = kd.right[n];
+                if (kd.boxDistance(p, l) < kd.boxDistance(p, r))
+                    std::swap(l, r);
+                stack.push_back(l);
+                stack.push_back(r);
+            }
+        }
+
+        int added = 0;
+        for (int c = 0; c < V; ++c) {
+            if (comp[c] == c and best[c].a != -1 and S.union_(best[c].a, best[c].b)) {
+                addEdge(tree, kd.input[best[c].a], kd.input[best[c].b], best[c].d);
+                ++added;
+            }
+        }
+        if (added == 0)
+            throw std::runtime_error("boruvka - Round Added No Edge");
+    }
+}
+//===========================================
+// sweepDistances
+// this method adds to d[i] the squared difference of c[i] and x, for
+// the m slots of one coordinate, two slots at a time with SSE2.
+// params: the coordinates, the coordinate of the new vertex, the
+// distances, slot count
+// return value: none.
+//===========================================
+void sweepDistances(const double *c, const double x, double *d, const int m) {
+    int i = 0;
+#ifdef __SSE2__
+    const __m128d vx = _mm_set1_pd(x);
+    for (; i + 2 <= m; i += 2) {
+        __m128d t = _mm_sub_pd(_mm_loadu_pd(c + i), vx);
+        _mm_storeu_pd(d + i, _mm_add_pd(_mm_loadu_pd(d + i), _mm_mul_pd(t, t)));
+    }
+#endif
+    for (; i < m; ++i) {
+        double t = c[i] - x;
+        d[i] += t * t;
+    }
+}
+//===========================================
+// sweepKeys
+// this method lowers every key to its new distance where that is
+// closer, giving the slot its new parent, two slots at a time with
+// SSE2.
+// params: the distances, the keys, the parents, the new vertex, slot
+// count
+// return value: the lightest key.
+//===========================================
+double sweepKeys(const double *d, double *key, int *parent, const int u, const int m) {
+    double lightest = FAR;
+    int i = 0;
+#ifdef __SSE2__
+    __m128d low = _mm_set1_pd(FAR);
+    for (; i + 2 <= m; i += 2) {
+        __m128d vd = _mm_loadu_pd(d + i);
+        __m128d vk = _mm_loadu_pd(key + i);
+        int closer = _mm_movemask_pd(_mm_cmplt_pd(vd, vk));
+
+        vk = _mm_min_pd(vd, vk);
+        _mm_storeu_pd(key + i, vk);
+        low = _mm_min_pd(low, vk);
+        if (closer & 1)
+            parent[i] = u;
+        if (closer & 2)
+            parent[i + 1] = u;
+    }
+    double pair[2];
+    _mm_storeu_pd(pair, low);
+    lightest = std::min(pair[0], pair[1]);
+#endif
+    for (; i < m; ++i) {
+        if (d[i] < key[i]) {
+            key[i] = d[i];
+            parent[i] = u;
+        }
+        lightest = std::min(lightest, key[i]);
+    }
+    return lightest;
+}
+//===========================================
+// prim
+// this method runs Prim over the implicit complete graph. The vertices
+// not yet in the tree are kept packed at the front of the arrays, one
+// array per coordinate, so every step is a few sweeps without branches
+// on membership: the distances, the keys (and their minimum), then a
+// search for the slot holding that minimum.
+// params: the points, the tree (output)
+// return value: none.
+//===========================================
+void prim(const PointSet &points, EuclideanTree &tree) {
+    const int V = points.size();
+    const int D = points.dim;
+    int m = V - 1;      //vertices left, packed in [0, m)
+
+    std::vector<double> coord((size_t)D * m);   //coordinate k of slot i at k * m + i
+    std::vector<double> key(m, FAR), dist(m);
+    std::vector<int> parent(m, 0), id(m);
+
+    for (int i = 0; i < m; ++i) {
+        id[i] = i + 1;
+        for (int k = 0; k < D; ++k)
+            coord[(size_t)k * m + i] = points.at(i + 1, k);
+    }
+    const int stride = m;
+
+    int u = 0;
+    while (m > 0) {
+        std::fill(dist.begin(), dist.begin() + m, 0.0);
+        for (int k = 0; k < D; ++k)
+            sweepDistances(coord.data() + (size_t)k * stride, points.at(u, k), dist.data(), m);
+        double lightest = sweepKeys(dist.data(), key.data(), parent.data(), u, m);
+
+        int next = (int)(std::find(key.begin(), key.begin() + m, lightest) - key.begin());
+        u = id[next];
+        addEdge(tree, parent[next], u, key[next]);
+
+        //fill the hole with the last vertex left
+        --m;
+        id[next] = id[m];
+        key[next] = key[m];
+        parent[next] = parent[m];
+        for (int k = 0; k < D; ++k)
+            coord[(size_t)k * stride + next] = coord[(size_t)k * stride + m];
+    }
+}
+
+}
+
+//===========================================
+// readPoints
+// this method reads a point set: "nv dim", then the coordinates.
+// params: the input stream, the points (output)
+// return value: none.
+//===========================================
+void readPoints(std::istream &is, PointSet &points) {
+    int nv, dim;
+
+    if (!(is >> nv >> dim))
+        throw std::runtime_error("readPoints - Error reading header");
+    if (nv < 0 or dim < 1)
+        throw std::invalid_argument("readPoints - Invalid Header");
+
+    points.dim = dim;
+    points.coord.resize((size_t)nv * dim);
+    for (auto& x : points.coord) {
+        if (!(is >> x))
+            throw std::runtime_error("readPoints - Error reading coordinates");
+    }
+}
+//===========================================
+// euclideanMST
+// this method finds the Euclidean MST of the points.
+// params: the points, the tree (output), the method
+// return value: none.
+//===========================================
+void euclideanMST(const PointSet &points, EuclideanTree &tree, const EuclideanMethod method) {
+    if (points.dim < 1)
+        throw std::invalid_argument("euclideanMST - Invalid Dimension");
+
+    tree = EuclideanTree();
+    if (points.size() < 2)
+        return;
+
+    bool kd = (method == EuclideanMethod::KDTREE) or
+              (method == EuclideanMethod::AUTO and points.dim <= 3 and points.size() >= EUCLID_PRIM_POINTS);
+    if (kd)
+        boruvka(points, tree);
+    else
+        prim(points, tree);
+}
+//===========================================
+// cout
+// this method prints the tree.
+// params: ostream &os, the tree
+// return value: a reference to the output stream.
+//===========================================
+std::ostream& operator<<(std::ostream &os, const EuclideanTree &tree) {
+    std::streamsize precision = os.precision(10);
+
+    os << "Euclidean MST length " << tree.total << " (" << tree.edges() << " edges)\n";
+    for (int i = 0; i < tree.edges(); ++i)
+        os << tree.v1[i] << " " << tree.v2[i] << " " << tree.length[i] << "\n";
+    os.precision(precision);
+    return os;
+}
@@ -0,0 +1,60 @@
+//================================================================
+// EuclideanMST.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the Euclidean MST of a point set.
+// The complete graph of the points is never built:
+//     KDTREE  Boruvka rounds over a k-d tree; each point looks for
+//             its nearest point in another component, skipping the
+//             boxes that hold only its own component or are farther
+//             than the best edge its component has found so far
+//     PRIM    O(V^2) Prim computing the distances as it goes, with
+//             the vertices left kept packed so the inner loops are
+//             array sweeps, written with SSE2 where it is available
+// AUTO takes the k-d tree for up to three dimensions, Prim for small
+// sets and higher dimensions, where the boxes stop pruning.
+// Both give a tree of the same length; with equal distances they may
+// pick different edges.
+//================================================================
+
+#include <vector>
+#include <iostream>
+
+#ifndef EUCLIDEANMST_H
+#define EUCLIDEANMST_H
+
+//Below this many points Prim is cheaper than building the tree
+const int EUCLID_PRIM_POINTS = 512;
+//Points per leaf of the k-d tree
+const int KD_LEAF_POINTS = 8;
+
+enum class EuclideanMethod { AUTO, KDTREE, PRIM };
+
+//Points of any dimension, coordinates of point i at coord[i * dim]
+struct PointSet {
+    int dim = 2;
+    std::vector<double> coord;
+
+    int     size    (void) const { return dim > 0 ? (int)(coord.size() / dim) : 0; }
+    double  at      (const int i, const int k) const { return coord[(size_t)i * dim + k]; }
+};
+
+//Tree edges as flat arrays, in the order they were found
+struct EuclideanTree {
+    std::vector<int> v1;
+    std::vector<int> v2;
+    std::vector<double> length;
+    double total = 0;
+
+    int edges(void) const { return (int)length.size(); }
+};
+
+//Reads "nv dim" and then nv lines of dim coordinates
+void    readPoints  (std::istream &is, PointSet &points);
+void    euclideanMST(const PointSet &points, EuclideanTree &tree,
+                     const EuclideanMethod method = EuclideanMethod::AUTO);
+
+//Prints the total length, then one "v1 v2 length" line per edge
+std::ostream& operator<<(std::ostream &os, const EuclideanTree &tree);
+
+#endif
@@ -0,0 +1,467 @@
+//================================================================
+// Fuzz.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the Fuzz.cpp file that implements the differential MST
+// fuzzer. The reference is a Kruskal written here over a sorted edge
+// list with an ArrayDSU, sharing no code with the backends. Every case
+// is made from its own seed, so a failure can be reproduced alone.
+//================================================================
+
+#include "Fuzz.h"
+#include "SparseGraph.h"
+#include "DenseGraph.h"
+#include "GraphView.h"
+#include "CompactGraph.h"
+#include "ReorderedGraph.h"
+#include "GraphFactory.h"
+#include "MSTVerify.h"
+#include <random>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <sstream>
+#include <set>
+
+namespace {
+
+typedef std::tuple<int, int, int> Edge;
+
+//Minimum spanning forest of an edge list, by component
+struct Reference {
+    std::vector<Edge> edges;        //(min, max, w), no self-loops, sorted
+    std::vector<Edge> forest;       //sorted
+    std::vector<int> comp;          //component of each vertex
+    std::vector<int> comp_size;
+    std::vector<long long> comp_mass;
+};
+
+//===========================================
+// buildReference
+// this method runs Kruskal over the edge list.
+// params: vertex count, the edges, the reference (output)
+// return value: none.
+//===========================================
+void buildReference(const int V, const std::vector<Edge> &input, Reference &ref) {
+    ref.edges.clear();
+    for (const auto& e : input) {
+        int a = std::get<0>(e), b = std::get<1>(e);
+        if (a != b)
+            ref.edges.emplace_back(std::min(a, b), std::max(a, b), std::get<2>(e));
+    }
+    std::sort(ref.edges.begin(), ref.edges.end());
+
+    std::vector<Edge> by_weight(ref.edges);
+    std::stable_sort(by_weight.begin(), by_weight.end(), [](const Edge &x, const Edge &y) {
+        return std::get<2>(x) < std::get<2>(y);
+    });
+
+    ArrayDSU S(V);
+    ref.forest.clear();
+    for (const auto& e : by_weight) {
+        if (S.union_(std::get<0>(e), std::get<1>(e)))
+            ref.forest.push_back(e);
+    }
+    std::sort(ref.forest.begin(), ref.forest.end());
+
+    std::vector<int> id(V, -1);
+    ref.comp.assign(V, 0);
+    ref.comp_size.clear();
+    for (int v = 0; v < V; ++v) {
+        int &c = id[S.find_(v)];
+        if (c == -1) {
+            c = (int)ref.comp_size.size();
+            ref.comp_size.push_back(0);
+        }
+        ref.comp[v] = c;
+        ref.comp_size[c]++;
+    }
+    ref.comp_mass.assign(ref.comp_size.size(), 0);
+    for (const auto& e : ref.forest)
+        ref.comp_mass[ref.comp[std::get<0>(e)]] += std::get<2>(e);
+}
+
+//===========================================
+// checkTree
+// this method checks one MST result against the reference. A whole
+// forest must span every component; otherwise the tree must span the
+// component of root and nothing else (root -1: any one component).
+// params: the reference, the result, whether it is a whole forest,
+//         the root, whether the weights are distinct
+// return value: the problem found, empty if none.
+//===========================================
+std::string checkTree(const Reference &ref, const Graph &tree, const bool whole, const int root, const bool distinct) {
+    const int V = (int)ref.comp.size();
+    std::ostringstream why;
+
+    if (tree.size() != V) {
+        why << "has " << tree.size() << " vertices instead of " << V;
+        return why.str();
+    }
+
+    std::vector<Edge> mine;
+    for (const auto& e : tree.getEdges()) {
+        int a = std::get<0>(e), b = std::get<1>(e);
+        mine.emplace_back(std::min(a, b), std::max(a, b), std::get<2>(e));
+    }
+    std::sort(mine.begin(), mine.end());
+
+    //every tree edge uses up one copy of a graph edge
+    std::vector<char> used(ref.edges.size(), 0);
+    for (const auto& e : mine) {
+        auto it = std::lower_bound(ref.edges.begin(), ref.edges.end(), e);
+        while (it != ref.edges.end() and *it == e and used[it - ref.edges.begin()])
+            ++it;
+        if (it == ref.edges.end() or *it != e) {
+            why << "edge (" << std::get<0>(e) << "," << std::get<1>(e) << "," << std::get<2>(e) << ") is not in the graph";
+            return why.str();
+        }
+        used[it - ref.edges.begin()] = 1;
+    }
+
+    ArrayDSU S(V);
+    std::vector<int> comp_edges(ref.comp_size.size(), 0);
+    for (const auto& e : mine) {
+        if (!S.union_(std::get<0>(e), std::get<1>(e))) {
+            why << "edge (" << std::get<0>(e) << "," << std::get<1>(e) << ") closes a cycle";
+            return why.str();
+        }
+        comp_edges[ref.comp[std::get<0>(e)]]++;
+    }
+
+    long long mass = 0, expected = 0;
+    int spanned = 0;
+    std::vector<char> keep(ref.comp_size.size(), 0);
+    for (size_t c = 0; c < ref.comp_size.size(); ++c) {
+        int need = ref.comp_size[c] - 1;
+        if (need == 0)
+            continue;
+        if (comp_edges[c] == need) {
+            keep[c] = 1;
+            ++spanned;
+            expected += ref.comp_mass[c];
+        }
+        else if (whole or comp_edges[c] > 0) {
+            why << "spans " << comp_edges[c] << " of the " << need << " edges of a component";
+            return why.str();
+        }
+    }
+    if (!whole) {
+        if (spanned > 1)
+            return "spans " + std::to_string(spanned) + " components, Prim should span one";
+        if (root != -1 and ref.comp_size[ref.comp[root]] > 1 and !keep[ref.comp[root]])
+            return "does not span the component of root " + std::to_string(root);
+    }
+
+    for (const auto& e : mine)
+        mass += std::get<2>(e);
+    if (mass != expected) {
+        why << "weighs " << mass << ", the reference " << expected;
+        return why.str();
+    }
+
+    if (distinct) {
+        std::vector<Edge> want;
+        for (const auto& e : ref.forest) {
+            if (keep[ref.comp[std::get<0>(e)]])
+                want.push_back(e);
+        }
+        if (want != mine)
+            return "weights are distinct but the edges differ from the reference";
+    }
+    return "";
+}
+
+//===========================================
+// pick
+// this method draws an integer in [lo, hi].
+// params: the generator, the bounds
+// return value: the integer.
+//===========================================
+int pick(std::mt19937_64 &rng, const int lo, const int hi) {
+    return std::uniform_int_distribution<int>(lo, hi)(rng);
+}
+
+}
+
+//===========================================
+// cout
+// this method prints a case in the input format of readGraph.
+// params: ostream &os, the case
+// return value: a reference to the output stream.
+//===========================================
+std::ostream& operator<<(std::ostream &os, const FuzzCase &c) {
+    os << c.vert_count << " " << c.edges.size() << "\n";
+    for (const auto& e : c.edges)
+        os << std::get<0>(e) << " " << std::get<1>(e) << " " << std::get<2>(e) << "\n";
+    return os;
+}
+//===========================================
+// makeFuzzCase
+// this method makes the random graph of a seed. The shape is one of
+// random, dense, disconnected, multi (parallel edges and self-loops),
+// ties (few distinct weights), distinct and tree.
+// params: the seed, the largest vertex count
+// return value: the case.
+//===========================================
+FuzzCase makeFuzzCase(const unsigned long seed, const int max_vertices) {
+    static const char* const shapes[] = { "random", "dense", "disconnected", "multi", "ties", "distinct", "tree" };
+    std::mt19937_64 rng(seed);
+    FuzzCase c;
+
+    int shape = pick(rng, 0, 6);
+    int V = pick(rng, 1, std::max(1, max_vertices));
+    //small weights go to the bucket Prim, large ones to the heap Prim
+    static const int heaviest[] = { 3, 100, BUCKET_PRIM_MAX_WEIGHT * 4 };
+    int W = heaviest[pick(rng, 0, 2)];
+    auto weight = [&]() { return pick(rng, 0, W - 1); };
+    auto vertex = [&]() { return pick(rng, 0, V - 1); };
+
+    c.vert_count = V;
+    c.shape = shapes[shape];
+    switch (shape) {
+        case 1:     //dense
+            for (int u = 0; u < V; ++u) {
+                for (int v = u + 1; v < V; ++v) {
+                    if (pick(rng, 0, 9) < 7)
+                        c.edges.emplace_back(u, v, weight());
+                }
+            }
+            break;
+        case 2: {   //disconnected: edges inside blocks only, some isolated vertices
+            std::vector<int> block(V);
+            int blocks = pick(rng, 1, std::max(1, V / 3));
+            for (auto& b : block)
+                b = pick(rng, 0, blocks);   //block `blocks` stays isolated
+            for (int i = pick(rng, 0, 3 * V); i > 0; --i) {
+                int u = vertex(), v = vertex();
+                if (u != v and block[u] == block[v] and block[u] != blocks)
+                    c.edges.emplace_back(u, v, weight());
+            }
+            break;
+        }
+        case 6:     //tree
+            for (int v = 1; v < V; ++v)
+                c.edges.emplace_back(pick(rng, 0, v - 1), v, weight());
+            break;
+        default:
+            for (int i = pick(rng, 0, 3 * V); i > 0; --i)
+                c.edges.emplace_back(vertex(), vertex(), weight());
+            break;
+    }
+
+    if (shape == 3) {   //multi: copies with other or equal weights, self-loops
+        size_t n = c.edges.size();
+        for (size_t i = 0; i < n; ++i) {
+            if (pick(rng, 0, 2) == 0) {
+                Edge e = c.edges[i];
+                std::get<2>(e) = pick(rng, 0, 1) ? weight() : std::get<2>(e);
+                if (pick(rng, 0, 1))
+                    std::swap(std::get<0>(e), std::get<1>(e));
+                c.edges.push_back(e);
+            }
+        }
+        for (int i = pick(rng, 0, 3); i > 0; --i) {
+            int v = vertex();
+            c.edges.emplace_back(v, v, weight());
+        }
+        std::shuffle(c.edges.begin(), c.edges.end(), rng);
+    }
+    else if (shape == 4) {  //ties
+        int levels = pick(rng, 1, 2);
+        for (auto& e : c.edges)
+            std::get<2>(e) = pick(rng, 0, levels - 1);
+    }
+    else if (shape == 5) {  //distinct
+        std::vector<int> w(c.edges.size());
+        for (size_t i = 0; i < w.size(); ++i)
+            w[i] = (int)i * pick(rng, 1, 3);
+        std::sort(w.begin(), w.end());
+        std::shuffle(w.begin(), w.end(), rng);
+        for (size_t i = 0; i < w.size(); ++i)
+            std::get<2>(c.edges[i]) = w[i];
+    }
+
+    std::set<int> seen;
+    c.distinct = true;
+    for (const auto& e : c.edges) {
+        if (std::get<0>(e) != std::get<1>(e) and !seen.insert(std::get<2>(e)).second)
+            c.distinct = false;
+    }
+    return c;
+}
+//===========================================
+// checkFuzzCase
+// this method builds the case in every backend, runs every MST
+// algorithm and checks each result. An engine that throws fails.
+// params: the case, the seed (picks the Prim root), the problems
+//         (output, one line per failing engine)
+// return value: the number of results checked.
+//===========================================
+int checkFuzzCase(const FuzzCase &c, const unsigned long seed, std::vector<std::string> &problems) {
+    const int V = c.vert_count;
+    const int E = (int)c.edges.size();
+    const int root = (int)(seed % V);
+    int checks = 0;
+
+    //DenseGraph keeps the first copy of a parallel edge
+    std::vector<Edge> first_copies;
+    std::set<std::pair<int, int>> pairs;
+    for (const auto& e : c.edges) {
+        int a = std::get<0>(e), b = std::get<1>(e);
+        if (pairs.insert(std::make_pair(std::min(a, b), std::max(a, b))).second)
+            first_copies.push_back(e);
+    }
+    Reference sparse_ref, dense_ref;
+    buildReference(V, c.edges, sparse_ref);
+    buildReference(V, first_copies, dense_ref);
+
+    std::string text;
+    {
+        std::ostringstream os;
+        os << c;
+        text = os.str();
+    }
+
+    SparseGraph sparse(V, E);
+    DenseGraph dense(V, E);
+    for (const auto& e : c.edges) {
+        sparse.insertEdge(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+        dense.insertEdge(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+    }
+    GraphView sparse_view(sparse), dense_view(dense);
+    CompactGraph compact(sparse);
+
+    //whole: the result is a Kruskal forest; root: -1 if not known
+    auto run = [&](const std::string &name, const Reference &ref, const GraphView &view,
+                   const bool whole, const int r, std::function<Graph*(void)> make) {
+        std::string why;
+        Graph *tree = nullptr;
+
+        try {
+            tree = make();
+            why = checkTree(ref, *tree, whole, r, c.distinct);
+            if (why.empty() and whole) {
+                MSTReport report;
+                verifyMST(view, *tree, report);
+                if (!report.valid)
+                    why = "verifyMST rejects it: " + report.error;
+            }
+        }
+        catch (const std::exception &ex) {
+            why = std::string("threw ") + ex.what();
+        }
+        delete tree;
+        ++checks;
+        if (!why.empty())
+            problems.push_back(name + ": " + why);
+    };
+
+    run("SparseGraph Prim", sparse_ref, sparse_view, false, root, [&]() { return sparse.MST_Prim(root); });
+    run("SparseGraph PrimHeap", sparse_ref, sparse_view, false, root, [&]() { return sparse.MST_PrimHeap(root); });
+    run("SparseGraph PrimBucket", sparse_ref, sparse_view, false, root, [&]() { return sparse.MST_PrimBucket(root); });
+    run("SparseGraph Kruskal", sparse_ref, sparse_view, true, -1, [&]() { return sparse.MST_Kruskal(); });
+    run("GraphView Prim", sparse_ref, sparse_view, false, root, [&]() { return sparse_view.MST_Prim(root); });
+    run("GraphView Kruskal", sparse_ref, sparse_view, true, -1, [&]() { return sparse_view.MST_Kruskal(); });
+    run("CompactGraph Prim", sparse_ref, sparse_view, false, root, [&]() { return compact.MST_Prim(root); });
+    run("CompactGraph Kruskal", sparse_ref, sparse_view, true, -1, [&]() { return compact.MST_Kruskal(); });
+    for (Ordering o : { Ordering::BFS, Ordering::RCM, Ordering::DEGREE }) {
+        std::string name = "ReorderedGraph(" + toString(o) + ") ";
+        run(name + "Prim", sparse_ref, sparse_view, false, 0, [&]() {
+            ReorderedGraph g(sparse, o);
+            return g.MST_Prim();
+        });
+        run(name + "Kruskal", sparse_ref, sparse_view, true, -1, [&]() {
+            ReorderedGraph g(sparse, o);
+            return g.MST_Kruskal();
+        });
+    }
+
+    run("DenseGraph Prim", dense_ref, dense_view, false, 0, [&]() { return dense.MST_Prim(); });
+    run("DenseGraph Kruskal", dense_ref, dense_view, true, -1, [&]() { return dense.MST_Kruskal(); });
+    run("GraphView(dense) Prim", dense_ref, dense_view, false, root, [&]() { return dense_view.MST_Prim(root); });
+    run("GraphView(dense) Kruskal", dense_ref, dense_view, true, -1, [&]() { return dense_view.MST_Kruskal(); });
+
+    //the factory paths: text parsing, parallel build, ingest
+    for (Backend b : { Backend::SPARSE, Backend::DENSE }) {
+        for (int threads : { 1, 2 }) {
+            for (bool dedup : { false, true }) {
+                for (MSTAlgorithm a : { MSTAlgorithm::PRIM, MSTAlgorithm::KRUSKAL }) {
+                    //the ingest keeps the lightest copy, so both backends see the sparse graph
+                    bool first = b == Backend::DENSE and !dedup;
+                    std::string name = "readGraph(" + toString(b) + ", " + std::to_string(threads) + " threads"
+                                     + (dedup ? ", dedup) " : ") ") + toString(a);
+
+                    run(name, first ? dense_ref : sparse_ref, first ? dense_view : sparse_view,
+                        a == MSTAlgorithm::KRUSKAL, 0, [&]() {
+                        GraphOptions opts;
+                        GraphChoice choice;
+                        opts.backend = b;
+                        opts.threads = threads;
+                        opts.dedup = dedup;
+                        opts.log = nullptr;
+
+                        std::istringstream is(text);
+                        Graph *g = readGraph(is, choice, opts);
+                        Graph *tree = nullptr;
+                        try {
+                            tree = computeMST(*g, a, threads);
+                        }
+                        catch (...) {
+                            delete g;
+                            throw;
+                        }
+                        delete g;
+                        return tree;
+                    });
+                }
+            }
+        }
+    }
+    return checks;
+}
+//===========================================
+// runFuzz
+// this method checks random cases until the case or time limit, or
+// the first failure if asked to stop there.
+// params: the options
+// return value: the report.
+//===========================================
+FuzzReport runFuzz(const FuzzOptions &opts) {
+    FuzzReport report;
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&start]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    for (long i = 0; opts.cases == 0 or i < opts.cases; ++i) {
+        if (opts.seconds > 0 and elapsed() >= opts.seconds)
+            break;
+
+        unsigned long seed = opts.seed + i;
+        FuzzCase c = makeFuzzCase(seed, opts.max_vertices);
+        std::vector<std::string> problems;
+
+        report.checks += checkFuzzCase(c, seed, problems);
+        report.cases++;
+
+        if (!problems.empty()) {
+            report.failures++;
+            if (report.first_failure.empty())
+                report.first_failure = "seed " + std::to_string(seed) + ": " + problems[0];
+            if (opts.log) {
+                *opts.log << "Fuzz: seed " << seed << " (" << c.shape << ", " << c.vert_count
+                          << " vertices, root " << seed % c.vert_count << ") failed\n";
+                for (const auto& p : problems)
+                    *opts.log << "    " << p << "\n";
+                *opts.log << c << std::flush;
+            }
+            if (opts.stop_on_failure)
+                break;
+        }
+        if (opts.log and report.cases % 1000 == 0)
+            *opts.log << "Fuzz: " << report.cases << " cases, " << report.failures << " failures, "
+                      << (long)elapsed() << "s" << std::endl;
+    }
+    return report;
+}
@@ -0,0 +1,66 @@
+//================================================================
+// Fuzz.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the differential MST fuzzer. It
+// makes random graphs (disconnected ones, parallel edges, self-loops,
+// equal weights, dense ones), runs every MST algorithm of every
+// backend on them and checks each result against a plain Kruskal over
+// the edge list:
+//     whole forests  (Kruskal) must span every component
+//     single trees   (Prim) must span exactly the component of their
+//                    root, or stay empty on an isolated vertex
+//     both           must use graph edges only, have no cycle, and
+//                    weigh as much as the reference on what they span;
+//                    with distinct weights the edges must be the same
+// The whole forests also go through verifyMST, so the verifier is
+// cross-checked at the same time. DenseGraph keeps the first copy of
+// a parallel edge, so its results are checked against that graph.
+// A failing case is printed in the input format, ready to replay.
+//================================================================
+
+#include "Graph.h"
+#include <vector>
+#include <tuple>
+#include <string>
+#include <iostream>
+
+#ifndef FUZZ_H
+#define FUZZ_H
+
+//Cases and vertex bound of the CI run
+const int FUZZ_CI_CASES = 300;
+const int FUZZ_CI_VERTICES = 24;
+
+struct FuzzOptions {
+    unsigned long   seed = 1;           //case i uses seed + i
+    long            cases = 0;          //0: no limit
+    double          seconds = 0;        //0: no limit
+    int             max_vertices = 40;
+    bool            stop_on_failure = true;
+    std::ostream   *log = &std::clog;   //progress and failures, nullptr: none
+};
+
+struct FuzzReport {
+    long            cases = 0;
+    long            checks = 0;         //MST results checked
+    long            failures = 0;
+    std::string     first_failure;      //empty if none
+};
+
+//A random input: edges as (v1, v2, w), in insertion order
+struct FuzzCase {
+    int             vert_count;
+    std::vector<std::tuple<int, int, int>> edges;
+    std::string     shape;
+    bool            distinct;           //no two edges share a weight
+};
+
+FuzzCase    makeFuzzCase(const unsigned long seed, const int max_vertices);
+//Runs every engine on c; the failures are appended to problems
+int         checkFuzzCase(const FuzzCase &c, const unsigned long seed, std::vector<std::string> &problems);
+FuzzReport  runFuzz     (const FuzzOptions &opts);
+
+std::ostream& operator<<(std::ostream &os, const FuzzCase &c);
+
+#endif
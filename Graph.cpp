@@ -8,8 +8,8 @@
 // cin and cout operators.
 //================================================================
 #include "Graph.h"
+#include "GraphIO.h"
 #include <tuple>
-#include <iomanip>
 #include <algorithm>
 //===========================================
 // cin
@@ -33,18 +33,28 @@ std::istream& operator>>(std::istream &is, Graph &gp) {
 }
 //===========================================
 // cout
-// this method prints a graph
+// this method prints a graph, through the buffered writer
 // params: ostream &os, const Graph &gp
 // return value: a reference to the output stream. 
 //===========================================
 std::ostream& operator<<(std::ostream &os, const Graph &gp) {
-    os << "G= (" << gp.vert_count << ", " << gp.edge_count << ") "<< std::endl;
-    for (const auto& e : gp.edges)
-        os << std::get<0>(e) << " " << std::get<1>(e) << " "<< std::get<2>(e) << std::endl;
-
+    writeGraph(os, gp);
     return os;
 }
 //===========================================
+// getWeights
+// this method looks up a batch of vertex pairs. Backends with a faster
+// way than one getWeight per pair override it.
+// params: the (v1, v2) pairs, the vector receiving the weights.
+// return value: none.
+//===========================================
+void Graph::getWeights(const std::vector<std::pair<int, int>> &pairs, std::vector<int> &out) const {
+    out.resize(pairs.size());
+
+    for (size_t i = 0; i < pairs.size(); ++i)
+        out[i] = getWeight(pairs[i].first, pairs[i].second);
+}
+//===========================================
 // printBFSTable
 // this method prints the table resulting from the BFS search algorithm
 // params: source vertex
@@ -54,10 +64,18 @@ void Graph::printBFSTable(int source) {
     if (table.size() != 3)
         throw std::runtime_error("printBFSTable - Invalid Table");
 
+    OutputWriter out(std::cout);
+    const std::vector<int> &dist = table["dist"];
+    const std::vector<int> &pred = table["pred"];
+
     for (int i=0; i < vert_count; ++i) {
-        std::cout << "[" << std::setw(3) << std::setfill(' ') << i << "]: " << "dist: " 
-                  << std::setw(2) << std::setfill(' ') << table["dist"][i] << "   pred: " 
-                  << std::setw(2) << std::setfill(' ') << table["pred"][i] << std::endl; 
+        out << "[";
+        out.putInt(i, 3);
+        out << "]: " << "dist: ";
+        out.putInt(dist[i], 2);
+        out << "   pred: ";
+        out.putInt(pred[i], 2);
+        out << '\n';
     }
 }
 //===========================================
@@ -84,9 +102,10 @@ void Graph::printBFSPath(int s, int d) {
     }
     path.insert(path.begin(), s);
 
+    OutputWriter out(std::cout);
     for (const auto& vert : path)
-        std::cout << "v" << vert << " ";
-    std::cout << std::endl;
+        out << "v" << vert << " ";
+    out << '\n';
 }
 //===========================================
 // printMostDistant
@@ -120,7 +139,7 @@ void Graph::printMostDistant(int s) {
     for (int index : indices) {
         std::cout << "v" << index << " ";
     }
-    std::cout << "dist=" << max - s << std::endl;
+    std::cout << "dist=" << max << std::endl;
 }
 
 //===========================================
@@ -153,11 +172,19 @@ void Graph::printDFSTable(void) {
     if (table.size() != 4)
         throw std::runtime_error("printDFSTable - Invalid Table");
 
+    OutputWriter out(std::cout);
+    const std::vector<int> &pred = table["pred"];
+    const std::vector<int> &disc = table["disc"];
+    const std::vector<int> &f = table["f"];
+
     for (int i=0; i < vert_count; ++i) {
-        std::cout << "[" << std::setw(3) << std::setfill(' ') << i << "]: "
-                  << "dist: " << std::setw(2) << std::setfill(' ') << -1
-                  << "   pred: " << std::setw(2) << std::setfill(' ') << table["pred"][i]
-                  << "  (" << table["disc"][i] << "," << table["f"][i] << ")" << std::endl;
+        out << "[";
+        out.putInt(i, 3);
+        out << "]: " << "dist: ";
+        out.putInt(-1, 2);
+        out << "   pred: ";
+        out.putInt(pred[i], 2);
+        out << "  (" << disc[i] << "," << f[i] << ")" << '\n';
     }
 }
 
@@ -178,13 +205,14 @@ void Graph::printTopologicalSort(void) {
 
     std::sort(topo_sort.begin(), topo_sort.end(), std::greater<std::pair<int, int>>()); // sort the pairs from biggest to lowest 
 
+    OutputWriter out(std::cout);
     for (int i=0; i < topo_sort.size(); ++i) {
-        std::cout << "v" << topo_sort[i].second;    // print the vector after the topological sort.
+        out << "v" << topo_sort[i].second;    // print the vector after the topological sort.
 
         if (i != topo_sort.size() - 1)
-            std::cout << " > ";
+            out << " > ";
     }
-    std::cout << std::endl;
+    out << '\n';
 }
 //===========================================
 // printDFSParenthesization
@@ -206,13 +234,14 @@ void Graph::printDFSParenthesization(void) {
     std::sort(paren.begin(), paren.end());
 
     // check if discover or finish and print accordignly.
+    OutputWriter out(std::cout);
     for (const auto& x : paren) {
         if (std::get<2>(x) == 0)
-            std::cout << "(v" << std::get<1>(x) << " ";
+            out << "(v" << std::get<1>(x) << " ";
         else
-            std::cout << "v" << std::get<1>(x) << ") ";
+            out << "v" << std::get<1>(x) << ") ";
     }
-    std::cout << std::endl;
+    out << '\n';
 }
 //===========================================
 // classifyDFSEdges
@@ -227,25 +256,52 @@ void Graph::classifyDFSEdges(void) {
     if (table.size() != 4)
         throw std::runtime_error("classifyDFSEdges - Invalid Table");
 
+    OutputWriter out(std::cout);
+    const std::vector<int> &disc = table["disc"];
+    const std::vector<int> &f = table["f"];
+
     for (const auto& edge : dfs_edges) {
-        std::cout << "Edge (v" << edge.first << ",v" << edge.second << ") is a ";
+        out << "Edge (v" << edge.first << ",v" << edge.second << ") is a ";
         // if u.d < v.d < v.f < u.f then tree/forward edge
-        if (table["disc"][edge.second] > table["disc"][edge.first] and table["f"][edge.second] < table["f"][edge.first])
-            std::cout << "tree/forward edge" << std::endl;
+        if (disc[edge.second] > disc[edge.first] and f[edge.second] < f[edge.first])
+            out << "tree/forward edge" << '\n';
         // if v.d < u.d < u.f < v.f then tree/forward edge
-        if (table["disc"][edge.second] < table["disc"][edge.first] and table["f"][edge.second] > table["disc"][edge.first])
-            std::cout << "back edge" << std::endl;
+        if (disc[edge.second] < disc[edge.first] and f[edge.second] > disc[edge.first])
+            out << "back edge" << '\n';
         // v.d < v.f < u.d < u.f .
-        if (table["f"][edge.second] < table["disc"][edge.first] or table["disc"][edge.second] > table["f"][edge.first])
-            std::cout << "cross edge" << std::endl;
+        if (f[edge.second] < disc[edge.first] or disc[edge.second] > f[edge.first])
+            out << "cross edge" << '\n';
     }
 }
 
-int Graph::mass(void) {
-    int total = 0;
+//===========================================
+// mass
+// this method sums the weights of the edge set, in a long long since
+// a large tree of int weights can overflow an int.
+// params: none.
+// return value: the total weight.
+//===========================================
+long long Graph::mass(void) const {
+    long long total = 0;
 
     for (const auto& edge : edges) 
         total += std::get<2>(edge);
 
     return total;
-}
\ No newline at end of file
+}
+
+//===========================================
+// insertTreeEdge
+// this method records the edge (v1, v2, w) in the edge set of the graph
+// and counts it, without touching the backend storage. This is how the
+// MST algorithms build their resulting graph.
+// params: two vertices - v1, v2 and the weight value.
+// return value: none.
+//===========================================
+void Graph::insertTreeEdge(const int v1, const int v2, const int w) {
+    if (v1 >= vert_count or v2 >= vert_count or v1 < 0 or v2 < 0)
+        throw std::invalid_argument("insertTreeEdge - Invalid Vertices");
+
+    edges.insert(std::make_tuple(v1, v2, w));
+    edge_count++;
+}
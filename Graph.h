@@ -28,6 +28,7 @@ class Graph {
     protected:
         int vert_count;
         int edge_count;
+        int max_weight;     //largest weight inserted so far, -1 if none
 
         //Information table
         std::map<std::string, std::vector<int>> table;
@@ -37,8 +38,8 @@ class Graph {
         std::set <std::tuple<int,int,int>> edges;
     public:
         //Constructors (STL handles initialization of table and dfs_edges)
-        Graph   (void) : vert_count(DEFAULT), edge_count(0) {}
-        Graph   (const int V, const int E) : vert_count(V), edge_count(E) {}
+        Graph   (void) : vert_count(DEFAULT), edge_count(0), max_weight(-1) {}
+        Graph   (const int V, const int E) : vert_count(V), edge_count(E), max_weight(-1) {}
         Graph   (const Graph &myGraph);
 
         //Destructor (No memory management needed)
@@ -52,6 +53,10 @@ class Graph {
         virtual bool    isEdge      (const int v1, const int v2) const = 0;
         virtual void    insertEdge  (const int v1, const int v2, int w) = 0;
         virtual int     getWeight   (const int v1, const int v2) const = 0;
+        //Weight of every (v1, v2) pair of the batch, -1 where there is no edge
+        virtual void    getWeights  (const std::vector<std::pair<int, int>> &pairs, std::vector<int> &out) const;
+        //(neighbor, weight) pairs of v, in the order the traversals visit them
+        virtual void    getNeighbors(const int v, std::vector<std::pair<int, int>> &out) const = 0;
 
         //BFS-based Algorithms
         virtual void    BFS             (int source) = 0;
@@ -70,6 +75,12 @@ class Graph {
 
         //Helper
         int size(void) const { return vert_count; }
+        int numEdges(void) const { return edge_count; }
+        int maxWeight(void) const { return max_weight; }
+        const std::set<std::tuple<int,int,int>>& getEdges(void) const { return edges; }
+
+        //Records an edge in the edge set only, the way the MST algorithms build their result
+        void insertTreeEdge(const int v1, const int v2, const int w);
 
         struct sortbythird {
             bool operator()(const std::tuple<int, int, int>& a,  const std::tuple<int, int, int>& b) const
@@ -81,7 +92,7 @@ class Graph {
         //Project 7 algorithms:
         virtual Graph*  MST_Prim (void) = 0;
         virtual Graph*  MST_Kruskal (void) = 0;
-        int mass(void);
+        long long mass(void) const;     //sum of the weights in the edge set
 };
 
 #endif
\ No newline at end of file
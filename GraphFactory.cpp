@@ -0,0 +1,251 @@
+//================================================================
+// GraphFactory.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the GraphFactory.cpp file that implements the automatic
+// backend selection. The decision is made from the header of the
+// input ("nv ne") before any edge is read, so the wrong backend is
+// never built. Every decision is written to the log stream of the
+// options (std::clog by default) so it can be audited later.
+//================================================================
+
+#include "GraphFactory.h"
+#include "SparseGraph.h"
+#include "DenseGraph.h"
+#include <list>
+#include <sstream>
+#include <iomanip>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+//===========================================
+// sparseBytes
+// this method estimates the memory used by a SparseGraph: one list
+// node per direction of every edge plus the entries of the edge set.
+// params: vertices, edges
+// return value: estimated size in bytes.
+//===========================================
+size_t sparseBytes(const int V, const int E) {
+    const size_t list_node = sizeof(std::pair<int,int>) + 2 * sizeof(void*);
+    const size_t set_node  = sizeof(std::tuple<int,int,int>) + 4 * sizeof(void*);
+
+    return (size_t)V * sizeof(std::list<std::pair<int,int>>)
+         + 2 * (size_t)E * (list_node + set_node);
+}
+//===========================================
+// denseBytes
+// this method estimates the memory used by the adjacency matrix of
+// a DenseGraph (the edge set is the same for both backends and is
+// left out here).
+// params: vertices
+// return value: estimated size in bytes.
+//===========================================
+size_t denseBytes(const int V) {
+    return (size_t)V * (size_t)V * sizeof(int) + (size_t)V * sizeof(std::vector<int>);
+}
+//===========================================
+// availableMemory
+// this method returns the physical memory currently available.
+// returns 0 when the platform cannot tell, in which case memory
+// is not taken into account.
+// params: none
+// return value: available memory in bytes.
+//===========================================
+size_t availableMemory(void) {
+#if defined(_SC_AVPHYS_PAGES) && defined(_SC_PAGESIZE)
+    long pages = sysconf(_SC_AVPHYS_PAGES);
+    long page_size = sysconf(_SC_PAGESIZE);
+
+    if (pages > 0 and page_size > 0)
+        return (size_t)pages * (size_t)page_size;
+#endif
+    return 0;
+}
+//===========================================
+// chooseGraph
+// this method picks the backend and the MST algorithm for a graph
+// with V vertices and E edges. The matrix is used for dense graphs
+// as long as it fits in memory, the adjacency list otherwise.
+// Prim goes with the matrix (every row is scanned anyway) and
+// Kruskal with the list (it only touches the edges that exist).
+// Overrides in opts always win and are reported as such.
+// params: vertices, edges, options
+// return value: the choice made.
+//===========================================
+GraphChoice chooseGraph(const int V, const int E, const GraphOptions &opts) {
+    if (V < 0 or E < 0)
+        throw std::invalid_argument("chooseGraph - Invalid Header");
+
+    GraphChoice choice;
+    std::ostringstream reason;
+
+    double possible = (double)V * (V - 1) / 2.0;
+    choice.density = (possible > 0) ? E / possible : 0.0;
+
+    size_t dense = denseBytes(V);
+    size_t sparse = sparseBytes(V, E);
+    size_t avail = availableMemory();
+    bool dense_fits = (avail == 0) or dense <= DENSE_MEMORY_FRACTION * avail;
+
+    if (opts.backend != Backend::AUTO) {
+        choice.backend = opts.backend;
+        reason << "backend forced by caller";
+    }
+    else if (choice.density >= DENSE_THRESHOLD and dense_fits) {
+        choice.backend = Backend::DENSE;
+        reason << "density " << std::setprecision(3) << choice.density
+               << " >= " << DENSE_THRESHOLD << " and matrix fits in memory";
+    }
+    else if (choice.density >= DENSE_THRESHOLD) {
+        choice.backend = Backend::SPARSE;
+        reason << "density " << std::setprecision(3) << choice.density
+               << " >= " << DENSE_THRESHOLD << " but matrix does not fit in memory";
+    }
+    else {
+        choice.backend = Backend::SPARSE;
+        reason << "density " << std::setprecision(3) << choice.density
+               << " < " << DENSE_THRESHOLD;
+    }
+
+    if (opts.algorithm != MSTAlgorithm::AUTO) {
+        choice.algorithm = opts.algorithm;
+        reason << "; algorithm forced by caller";
+    }
+    else
+        choice.algorithm = (choice.backend == Backend::DENSE) ? MSTAlgorithm::PRIM : MSTAlgorithm::KRUSKAL;
+
+    size_t needed = (choice.backend == Backend::DENSE) ? dense : sparse;
+    if (avail != 0 and needed > avail)
+        reason << "; WARNING: estimated " << needed << " bytes exceed " << avail << " available";
+
+    choice.reason = reason.str();
+
+    if (opts.log) {
+        *opts.log << "GraphFactory: nv=" << V << " ne=" << E
+                  << " sparse=" << sparse << "B dense=" << dense << "B avail=" << avail << "B"
+                  << " -> " << toString(choice.backend) << " + " << toString(choice.algorithm)
+                  << " (" << choice.reason << ")" << std::endl;
+    }
+    return choice;
+}
+//===========================================
+// makeGraph
+// this method builds an empty graph of the chosen backend.
+// params: vertices, edges, choice
+// return value: pointer to the new graph (owned by the caller).
+//===========================================
+Graph* makeGraph(const int V, const int E, const GraphChoice &choice) {
+    if (choice.backend == Backend::DENSE)
+        return new DenseGraph(V, E);
+    return new SparseGraph(V, E);
+}
+//===========================================
+// readGraph
+// this method reads the "nv ne" header, picks the backend and
+// reads the edges into it. With dedup the edges go through the
+// ingest stage first and the graph is sized for the edges kept. With
+// more than one thread the edges are parsed in parallel, and a
+// SparseGraph is laid out in parallel instead of edge by edge. A
+// SparseGraph is then relabeled if the options ask for an ordering.
+// params: istream &is, the choice made (output), options
+// return value: pointer to the new graph (owned by the caller).
+//===========================================
+Graph* readGraph(std::istream &is, GraphChoice &choice, const GraphOptions &opts) {
+    int nv, ne;
+
+    if (!(is >> nv >> ne))
+        throw std::runtime_error("readGraph - Error reading header");
+
+    std::vector<std::tuple<int, int, int>> edge_list;
+    IngestReport ingest;    //left empty when there is no ingest stage
+    if (opts.dedup) {
+        if (nv < 0 or ne < 0)
+            throw std::invalid_argument("readGraph - Invalid Header");
+
+        if (opts.threads > 1) {
+            edge_list = readEdgesParallel(is, ne, opts.threads);
+            normalizeEdges(edge_list, nv, ingest);
+        }
+        else
+            edge_list = ingestEdges(is, nv, ne, ingest);
+        if (opts.log)
+            *opts.log << "GraphFactory: ingest " << ingest << std::endl;
+        ne = (int)edge_list.size();
+    }
+
+    choice = chooseGraph(nv, ne, opts);
+    choice.ingest = ingest;
+    Graph *gp;
+
+    if (opts.threads > 1 and choice.backend == Backend::SPARSE) {
+        if (!opts.dedup)
+            edge_list = readEdgesParallel(is, ne, opts.threads);
+        gp = new SparseGraph(nv, ne, edge_list, opts.threads);
+    }
+    else {
+        gp = makeGraph(nv, ne, choice);
+
+        try {
+            if (opts.dedup)
+                loadEdges(*gp, edge_list);
+            else if (opts.threads > 1)
+                loadEdges(*gp, readEdgesParallel(is, ne, opts.threads));
+            else
+                is >> (*gp);
+        }
+        catch (...) {
+            delete gp;
+            throw;
+        }
+    }
+    if (opts.log and opts.threads > 1)
+        *opts.log << "GraphFactory: parallel build with " << opts.threads << " threads" << std::endl;
+
+    if (opts.ordering != Ordering::NONE) {
+        SparseGraph *sparse = dynamic_cast<SparseGraph*>(gp);
+
+        if (sparse) {
+            gp = new ReorderedGraph(*sparse, opts.ordering);
+            delete sparse;
+        }
+        if (opts.log)
+            *opts.log << "GraphFactory: ordering " << toString(opts.ordering)
+                      << (sparse ? " applied" : " skipped (needs SparseGraph)") << std::endl;
+    }
+    return gp;
+}
+//===========================================
+// computeMST
+// this method runs the requested MST algorithm on the graph.
+// AUTO runs Prim, as main always did. Kruskal on a DenseGraph of at
+// least DENSE_PARALLEL_VERTICES vertices uses the threads given.
+// params: Graph &g, algorithm, thread count
+// return value: pointer to the MST (owned by the caller).
+//===========================================
+Graph* computeMST(Graph &g, const MSTAlgorithm algorithm, const int threads) {
+    if (algorithm == MSTAlgorithm::KRUSKAL) {
+        DenseGraph *dense = dynamic_cast<DenseGraph*>(&g);
+        if (dense and threads > 1 and dense->size() >= DENSE_PARALLEL_VERTICES)
+            return dense->MST_Kruskal(threads);
+        return g.MST_Kruskal();
+    }
+    return g.MST_Prim();
+}
+
+std::string toString(const Backend b) {
+    switch (b) {
+        case Backend::SPARSE: return "SparseGraph";
+        case Backend::DENSE:  return "DenseGraph";
+        default:              return "auto";
+    }
+}
+
+std::string toString(const MSTAlgorithm a) {
+    switch (a) {
+        case MSTAlgorithm::PRIM:    return "Prim";
+        case MSTAlgorithm::KRUSKAL: return "Kruskal";
+        default:                    return "auto";
+    }
+}
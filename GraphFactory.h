@@ -0,0 +1,60 @@
+//================================================================
+// GraphFactory.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the graph factory. The factory
+// reads the "nv ne" header of an input graph and decides which
+// backend (SparseGraph or DenseGraph) and which MST algorithm
+// (Prim or Kruskal) to use, based on the density of the graph, the
+// number of vertices and the memory available on the machine.
+// Callers may override either choice.
+//================================================================
+
+#include "Graph.h"
+#include "ReorderedGraph.h"
+#include "EdgeIngest.h"
+#include <iostream>
+#include <string>
+
+#ifndef GRAPHFACTORY_H
+#define GRAPHFACTORY_H
+
+enum class Backend      { AUTO, SPARSE, DENSE };
+enum class MSTAlgorithm { AUTO, PRIM, KRUSKAL };
+
+//Above this fraction of the possible edges the matrix is the better fit
+const double DENSE_THRESHOLD = 0.25;
+//Fraction of the available memory the matrix is allowed to take
+const double DENSE_MEMORY_FRACTION = 0.5;
+
+struct GraphOptions {
+    Backend         backend   = Backend::AUTO;
+    MSTAlgorithm    algorithm = MSTAlgorithm::AUTO;
+    Ordering        ordering  = Ordering::NONE;     //SparseGraph only
+    bool            dedup     = false;  //run the ingest stage before building
+    int             threads   = 1;      //above 1: parse, build (and dense Kruskal) in parallel
+    std::ostream   *log       = &std::clog;   //nullptr: no decision log
+};
+
+struct GraphChoice {
+    Backend         backend;
+    MSTAlgorithm    algorithm;
+    double          density;
+    std::string     reason;
+    IngestReport    ingest;     //filled when dedup is on, empty otherwise
+};
+
+//Estimates (in bytes) for each backend
+size_t  sparseBytes     (const int V, const int E);
+size_t  denseBytes      (const int V);
+size_t  availableMemory (void);
+
+GraphChoice chooseGraph (const int V, const int E, const GraphOptions &opts = GraphOptions());
+Graph*      makeGraph   (const int V, const int E, const GraphChoice &choice);
+Graph*      readGraph   (std::istream &is, GraphChoice &choice, const GraphOptions &opts = GraphOptions());
+Graph*      computeMST  (Graph &g, const MSTAlgorithm algorithm, const int threads = 1);
+
+std::string toString(const Backend b);
+std::string toString(const MSTAlgorithm a);
+
+#endif
@@ -0,0 +1,174 @@
+//================================================================
+// GraphIO.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the GraphIO.cpp file that implements the buffered writer
+// and the graph writers. Integers are written right to left into a
+// small scratch array, then copied into the buffer behind the padding.
+//================================================================
+
+#include "GraphIO.h"
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+//===========================================
+// Constructor
+// params: the stream written to, buffer size in bytes
+// return value: none
+//===========================================
+OutputWriter::OutputWriter(std::ostream &out, const size_t capacity) : \
+    os(out), buf(capacity < 64 ? 64 : capacity), used(0) {}
+//===========================================
+// Destructor
+// this method writes whatever is left in the buffer and flushes the
+// stream.
+//===========================================
+OutputWriter::~OutputWriter(void) {
+    if (used > 0)
+        os.write(buf.data(), used);
+    os.flush();
+}
+//===========================================
+// flush
+// this method writes the buffer to the stream and empties it.
+// params: none
+// return value: none
+//===========================================
+void OutputWriter::flush(void) {
+    if (used > 0)
+        os.write(buf.data(), used);
+    used = 0;
+    if (!os)
+        throw std::runtime_error("flush - Error writing output");
+}
+//===========================================
+// put
+// this method appends a string.
+// params: the string
+// return value: none
+//===========================================
+void OutputWriter::put(const char *s) {
+    putRaw(s, std::strlen(s));
+}
+
+void OutputWriter::put(const std::string &s) {
+    putRaw(s.data(), s.size());
+}
+//===========================================
+// putRaw
+// this method appends n bytes. Blocks larger than the buffer are
+// written straight to the stream.
+// params: the bytes, their count
+// return value: none
+//===========================================
+void OutputWriter::putRaw(const void *data, const size_t n) {
+    reserve(n);
+    if (n > buf.size()) {
+        os.write((const char*)data, n);
+        return;
+    }
+    std::memcpy(buf.data() + used, data, n);
+    used += n;
+}
+//===========================================
+// putInt
+// this method appends x in decimal, padded on the left with spaces to
+// width characters (the sign counts, as with std::setw).
+// params: the integer, the field width
+// return value: none
+//===========================================
+void OutputWriter::putInt(long long x, const int width) {
+    char digits[24];
+    char *end = digits + sizeof(digits);
+    char *p = end;
+
+    unsigned long long u = (x < 0) ? 0ULL - (unsigned long long)x : (unsigned long long)x;
+    do {
+        *--p = (char)('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (x < 0)
+        *--p = '-';
+
+    size_t len = end - p;
+    size_t pad = (width > (int)len) ? width - len : 0;
+
+    reserve(pad + len);
+    for (size_t i = 0; i < pad; ++i)
+        buf[used++] = ' ';
+    std::memcpy(buf.data() + used, p, len);
+    used += len;
+}
+//===========================================
+// writeGraph
+// this method prints a graph in the format of operator<<.
+// params: ostream &os, const Graph &g
+// return value: none
+//===========================================
+void writeGraph(std::ostream &os, const Graph &g) {
+    OutputWriter out(os);
+
+    out << "G= (" << g.size() << ", " << g.numEdges() << ") " << '\n';
+    for (const auto& e : g.getEdges())
+        out << std::get<0>(e) << ' ' << std::get<1>(e) << ' ' << std::get<2>(e) << '\n';
+}
+//===========================================
+// writeBinary
+// this method writes the edges of a graph (an MST) in the binary
+// format described in GraphIO.h.
+// params: ostream &os, const Graph &g
+// return value: none
+//===========================================
+void writeBinary(std::ostream &os, const Graph &g) {
+    OutputWriter out(os);
+
+    auto put32 = [&out](const int32_t x) {
+        uint32_t u = (uint32_t)x;
+        char b[4] = { (char)u, (char)(u >> 8), (char)(u >> 16), (char)(u >> 24) };
+        out.putRaw(b, 4);
+    };
+
+    out.putRaw("MSTB", 4);
+    put32(g.size());
+    put32((int32_t)g.getEdges().size());
+    for (const auto& e : g.getEdges()) {
+        put32(std::get<0>(e));
+        put32(std::get<1>(e));
+        put32(std::get<2>(e));
+    }
+}
+//===========================================
+// readBinary
+// this method reads a graph in the binary format described in
+// GraphIO.h. Throws if the magic, the counts or the length are wrong;
+// the edges themselves are checked when they are inserted.
+// params: istream &is, the vertex count (output), the edges (output)
+// return value: none
+//===========================================
+void readBinary(std::istream &is, int &V, std::vector<std::tuple<int, int, int>> &edge_list) {
+    char magic[4];
+
+    auto get32 = [&is]() {
+        unsigned char b[4];
+        if (!is.read((char*)b, 4))
+            throw std::runtime_error("readBinary - Truncated File");
+        return (int32_t)(b[0] | (uint32_t)b[1] << 8 | (uint32_t)b[2] << 16 | (uint32_t)b[3] << 24);
+    };
+
+    if (!is.read(magic, 4) or std::memcmp(magic, "MSTB", 4) != 0)
+        throw std::runtime_error("readBinary - Not an MSTB File");
+    V = get32();
+    int E = get32();
+    if (V < 0 or E < 0)
+        throw std::runtime_error("readBinary - Invalid Header");
+
+    edge_list.clear();
+    edge_list.reserve(std::min(E, 1 << 20));     //E is not trusted yet
+    for (int i = 0; i < E; ++i) {
+        int v1 = get32();
+        int v2 = get32();
+        int w = get32();
+        edge_list.emplace_back(v1, v2, w);
+    }
+}
@@ -0,0 +1,69 @@
+//================================================================
+// GraphIO.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the fast output path. OutputWriter
+// collects text in a large buffer and formats integers by hand, so a
+// graph of millions of edges is written in a few large writes instead
+// of one formatted insertion (and one flush) per value. The printers
+// of Graph go through it and produce the same bytes as before.
+// The binary MST format is, all little-endian:
+//     "MSTB", int32 vertices, int32 edges, then (v1, v2, w) int32 triples
+// readBinary takes every triple as one edge. A whole graph written
+// this way holds both directions of its edges, which does not change
+// its MST.
+//================================================================
+
+#include "Graph.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <tuple>
+
+#ifndef GRAPHIO_H
+#define GRAPHIO_H
+
+const size_t OUTPUT_BUFFER_SIZE = 1 << 16;
+
+class OutputWriter {
+    private:
+        std::ostream &os;
+        std::vector<char> buf;
+        size_t used;
+
+        void reserve(const size_t n) { if (used + n > buf.size()) flush(); }
+
+    public:
+        OutputWriter    (std::ostream &out, const size_t capacity = OUTPUT_BUFFER_SIZE);
+        ~OutputWriter   (void);
+
+        OutputWriter(const OutputWriter &other) = delete;
+        OutputWriter& operator=(const OutputWriter &other) = delete;
+
+        //Writes the buffer to the stream; the stream itself is flushed
+        //only by the destructor
+        void flush(void);
+
+        void put(const char c) { reserve(1); buf[used++] = c; }
+        void put(const char *s);
+        void put(const std::string &s);
+        //Decimal integer, right-aligned with spaces to width (like std::setw)
+        void putInt(long long x, const int width = 0);
+        void putRaw(const void *data, const size_t n);
+
+        OutputWriter& operator<<(const char c) { put(c); return *this; }
+        OutputWriter& operator<<(const char *s) { put(s); return *this; }
+        OutputWriter& operator<<(const std::string &s) { put(s); return *this; }
+        OutputWriter& operator<<(const int x) { putInt(x); return *this; }
+        OutputWriter& operator<<(const long long x) { putInt(x); return *this; }
+        OutputWriter& operator<<(const size_t x) { putInt((long long)x); return *this; }
+};
+
+//Text output of operator<<, and the binary MST format
+void    writeGraph      (std::ostream &os, const Graph &g);
+void    writeBinary     (std::ostream &os, const Graph &g);
+//Reads the binary format back as a vertex count and an edge list
+void    readBinary      (std::istream &is, int &V, std::vector<std::tuple<int, int, int>> &edge_list);
+
+#endif
@@ -0,0 +1,246 @@
+//================================================================
+// GraphView.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the GraphView.cpp file that implements the read-only
+// GraphView class. Nothing in here writes to the view after the
+// constructor, so every method may be called concurrently.
+//================================================================
+
+#include "GraphView.h"
+#include "MSTCore.h"
+#include <stdexcept>
+#include <algorithm>
+
+//===========================================
+// tracePath
+// this method follows the predecessors from d back to s.
+// params: predecessor array, source s, destination d.
+// return value: the vertices from s to d, empty if there is no path.
+//===========================================
+std::vector<int> tracePath(const std::vector<int> &pred, const int s, const int d) {
+    std::vector<int> path;
+
+    if (s < 0 or d < 0 or s >= (int)pred.size() or d >= (int)pred.size())
+        throw std::invalid_argument("tracePath - Invalid Vertices");
+
+    for (int curr = d; curr != s; curr = pred[curr]) {
+        if (curr == -1 or path.size() >= pred.size())
+            return std::vector<int>();
+        path.push_back(curr);
+    }
+    path.push_back(s);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+//===========================================
+// Constructor
+// this method copies the adjacency of g, in the order the backend
+// traverses it.
+// params: Graph &g
+// return value: none
+//===========================================
+GraphView::GraphView(const Graph &g) : \
+    vert_count(g.size()), edge_count(g.numEdges()), max_weight(g.maxWeight()), offset(g.size() + 1, 0) {
+    std::vector<std::pair<int, int>> adj;
+
+    for (int v = 0; v < vert_count; ++v) {
+        g.getNeighbors(v, adj);
+        for (const auto& edge : adj) {
+            target.push_back(edge.first);
+            weight.push_back(edge.second);
+        }
+        offset[v + 1] = target.size();
+    }
+}
+//===========================================
+// isEdge
+// this method returns true if there is an edge from v1 to v2.
+// params: two vertices - v1, v2.
+// return value: boolean value
+//===========================================
+bool GraphView::isEdge(const int v1, const int v2) const {
+    return getWeight(v1, v2) >= 0;
+}
+//===========================================
+// getWeight
+// this method returns the weight of the first edge from v1 to v2,
+// -1 if there is none.
+// params: two vertices - v1, v2.
+// return value: the weight.
+//===========================================
+int GraphView::getWeight(const int v1, const int v2) const {
+    if (v1 >= vert_count or v2 >= vert_count or v1 < 0 or v2 < 0)
+        throw std::invalid_argument("getWeight - Invalid Vertices");
+
+    for (size_t i = offset[v1]; i < offset[v1 + 1]; ++i) {
+        if (target[i] == v2)
+            return weight[i];
+    }
+    return -1;
+}
+//===========================================
+// BFS
+// breadth first search from source into the caller's state.
+// params: source vertex, the state to fill.
+// return value: none.
+//===========================================
+void GraphView::BFS(const int source, BFSState &state) const {
+    if (source < 0 or source > vert_count - 1)
+        throw std::invalid_argument("BFS - source out of range");
+
+    state.color.assign(vert_count, 0);
+    state.dist.assign(vert_count, -1);
+    state.pred.assign(vert_count, -1);
+    state.queue.clear();
+    state.queue.reserve(vert_count);
+
+    state.color[source] = 1;
+    state.dist[source] = 0;
+    state.queue.push_back(source);
+
+    for (size_t head = 0; head < state.queue.size(); ++head) {
+        int u = state.queue[head];
+
+        for (size_t i = offset[u]; i < offset[u + 1]; ++i) {
+            int v = target[i];
+
+            if (state.color[v] == 0) {
+                state.color[v] = 1;
+                state.dist[v] = state.dist[u] + 1;
+                state.pred[v] = u;
+                state.queue.push_back(v);
+            }
+        }
+        state.color[u] = 2;
+    }
+}
+//===========================================
+// isConnected
+// this method returns true if the BFS of state reached every vertex.
+// params: the state of a previous BFS.
+// return value: boolean value.
+//===========================================
+bool GraphView::isConnected(const BFSState &state) const {
+    if ((int)state.color.size() != vert_count)
+        throw std::runtime_error("isConnected - Invalid State");
+
+    if (vert_count == 0)
+        return false;
+
+    for (int i = 0; i < vert_count; ++i) {
+        if (state.color[i] == 0)
+            return false;
+    }
+    return true;
+}
+//===========================================
+// printBFSPath
+// this method prints the path from s to d found by a BFS from s.
+// params: int s, int d, the state of the BFS, the output stream.
+// return value: nothing.
+//===========================================
+void GraphView::printBFSPath(const int s, const int d, const BFSState &state, std::ostream &os) const {
+    if ((int)state.pred.size() != vert_count)
+        throw std::runtime_error("printBFSPath - Invalid State");
+
+    std::vector<int> path = tracePath(state.pred, s, d);
+
+    if (path.empty()) {
+        os << "No such path\n";
+        return;
+    }
+    for (const auto& vert : path)
+        os << "v" << vert << " ";
+    os << "\n";
+}
+//===========================================
+// DFS
+// depth first search into the caller's state. The recursion of the
+// backends is replaced by an explicit stack of (vertex, next edge)
+// frames, which visits the edges in exactly the same order.
+// params: the state to fill.
+// return value: none.
+//===========================================
+void GraphView::DFS(DFSState &state) const {
+    state.color.assign(vert_count, 0);
+    state.pred.assign(vert_count, -1);
+    state.disc.assign(vert_count, -1);
+    state.f.assign(vert_count, -1);
+    state.edges.clear();
+    state.stack.clear();
+
+    int clock = 0;
+    for (int s = 0; s < vert_count; ++s) {
+        if (state.color[s] != 0)
+            continue;
+
+        state.disc[s] = ++clock;
+        state.color[s] = 1;
+        state.stack.emplace_back(s, offset[s]);
+
+        while (!state.stack.empty()) {
+            int u = state.stack.back().first;
+            size_t &i = state.stack.back().second;
+
+            if (i == offset[u + 1]) {
+                state.f[u] = ++clock;
+                state.color[u] = 2;
+                state.stack.pop_back();
+                continue;
+            }
+
+            int v = target[i++];
+            state.edges.emplace_back(u, v);
+
+            if (state.color[v] == 0) {
+                state.pred[v] = u;
+                state.disc[v] = ++clock;
+                state.color[v] = 1;
+                state.stack.emplace_back(v, offset[v]);
+            }
+        }
+    }
+}
+//===========================================
+// MST_Prim
+// Prim's algorithm grown from root, with the bucket queue when the
+// weights are small (as SparseGraph::MST_Prim).
+// params: the root vertex.
+// return value: pointer to the MST (owned by the caller).
+//===========================================
+SparseGraph* GraphView::MST_Prim(const int root) const {
+    SparseGraph* mst_graph = new SparseGraph(vert_count, 0);
+
+    auto forEach = [this](int u, auto f) {
+        for (size_t i = offset[u]; i < offset[u + 1]; ++i)
+            f(target[i], weight[i]);
+    };
+
+    try {
+        if (max_weight < BUCKET_PRIM_MAX_WEIGHT)
+            primBucket(vert_count, max_weight, root, forEach, *mst_graph);
+        else
+            primHeap(vert_count, root, forEach, *mst_graph);
+    }
+    catch (...) {
+        delete mst_graph;
+        throw;
+    }
+    return mst_graph;
+}
+//===========================================
+// MST_Kruskal
+// Kruskal's algorithm over the arcs of the view.
+// params: none.
+// return value: pointer to the MST (owned by the caller).
+//===========================================
+SparseGraph* GraphView::MST_Kruskal(void) const {
+    SparseGraph* mst_graph = new SparseGraph(vert_count, 0);
+
+    kruskal(vert_count, [this](int u, auto f) {
+        for (size_t i = offset[u]; i < offset[u + 1]; ++i)
+            f(target[i], weight[i]);
+    }, *mst_graph);
+    return mst_graph;
+}
@@ -0,0 +1,82 @@
+//================================================================
+// GraphView.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the GraphView class. A GraphView
+// is a frozen copy of a graph (any backend) in compressed sparse row
+// form. It is never modified after construction and all its queries
+// are const: the BFS and DFS results go to a state object owned by
+// the caller. One view can therefore be shared by many threads, each
+// with its own state, without locks or copies.
+// The neighbors keep the order of the backend the view was made
+// from, so BFS, DFS and MST results are the same as the backend's.
+//================================================================
+
+#include "Graph.h"
+#include "SparseGraph.h"
+#include <vector>
+#include <iostream>
+
+#ifndef GRAPHVIEW_H
+#define GRAPHVIEW_H
+
+//Results of a BFS, indexed by vertex. dist is -1 for unreachable vertices.
+struct BFSState {
+    std::vector<int> color;     //0: W, 1: G, 2: B
+    std::vector<int> dist;
+    std::vector<int> pred;      //-1: NIL
+    std::vector<int> queue;
+};
+
+//Results of a DFS, indexed by vertex, plus the edges in visit order.
+struct DFSState {
+    std::vector<int> color;
+    std::vector<int> pred;
+    std::vector<int> disc;
+    std::vector<int> f;
+    std::vector<std::pair<int, int>> edges;
+    std::vector<std::pair<int, size_t>> stack;  //(vertex, next edge)
+};
+
+//Path s -> d following pred, empty if d was not reached from s
+std::vector<int> tracePath(const std::vector<int> &pred, const int s, const int d);
+
+class GraphView {
+    private:
+        int vert_count;
+        int edge_count;
+        int max_weight;
+
+        std::vector<size_t> offset;     //edges of v: [offset[v], offset[v+1])
+        std::vector<int> target;
+        std::vector<int> weight;
+    public:
+        explicit GraphView(const Graph &g);
+
+        int size(void) const { return vert_count; }
+        int numEdges(void) const { return edge_count; }
+        int maxWeight(void) const { return max_weight; }
+        size_t numArcs(void) const { return target.size(); }
+
+        //Neighbors of v as a range of targets and weights
+        int         degree  (const int v) const { return (int)(offset[v + 1] - offset[v]); }
+        const int*  targets (const int v) const { return target.data() + offset[v]; }
+        const int*  weights (const int v) const { return weight.data() + offset[v]; }
+
+        bool    isEdge      (const int v1, const int v2) const;
+        int     getWeight   (const int v1, const int v2) const;
+
+        //BFS-based Algorithms
+        void    BFS             (const int source, BFSState &state) const;
+        bool    isConnected     (const BFSState &state) const;
+        void    printBFSPath    (const int s, const int d, const BFSState &state, std::ostream &os) const;
+
+        //DFS-based Algorithms
+        void    DFS             (DFSState &state) const;
+
+        //MST algorithms, same choice of Prim version as SparseGraph
+        SparseGraph*    MST_Prim    (const int root = 0) const;
+        SparseGraph*    MST_Kruskal (void) const;
+};
+
+#endif
@@ -0,0 +1,165 @@
+//================================================================
+// MSTCore.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file holds the MST algorithms written once for any adjacency
+// storage: SparseGraph and the read-only graph formats (GraphView,
+// CompactGraph) all run their Prim through them. The adjacency is given as a function
+// forEach(u, f) that calls f(v, w) for every edge (u, v, w), in the
+// order a traversal of that storage would see them. With the same
+// order, the result is the same for every storage.
+// The tree edges are recorded in mst with insertTreeEdge.
+//================================================================
+
+#include "Graph.h"
+#include "DisjointSet.h"
+#include <vector>
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+
+#ifndef MSTCORE_H
+#define MSTCORE_H
+
+//===========================================
+// primHeap
+// Prim's algorithm with a binary heap of candidate edges.
+// params: vertices, root, adjacency, graph receiving the tree.
+// return value: none.
+//===========================================
+template <class ForEach>
+void primHeap(const int V, const int root, ForEach forEach, Graph &mst) {
+    if (root < 0 or root >= V)
+        throw std::invalid_argument("MST_Prim - Invalid Root");
+
+    std::priority_queue<std::tuple<int, int, int>, std::vector<std::tuple<int, int, int>>, Graph::sortbythird> pq;
+    std::vector<char> intree(V, 0);
+    int remaining = V - 1;
+
+    intree[root] = 1;
+    forEach(root, [&](int v, int w) {
+        pq.push(std::make_tuple(root, v, w));
+    });
+
+    while (remaining > 0 and !pq.empty()) {
+        auto uvw = pq.top();
+        pq.pop();
+
+        int v = std::get<1>(uvw);
+        if (intree[v])
+            continue;
+
+        mst.insertTreeEdge(std::get<0>(uvw), v, std::get<2>(uvw));
+        intree[v] = 1;
+        --remaining;
+
+        forEach(v, [&](int x, int w) {
+            if (!intree[x])
+                pq.push(std::make_tuple(v, x, w));
+        });
+    }
+}
+//===========================================
+// primBucket
+// Prim's algorithm with a bucket queue indexed by weight, for graphs
+// whose weights are all small. A candidate edge is only queued when
+// it improves the best known connection (key) of its endpoint, and a
+// bitmap of the non empty buckets finds the lightest one 64 buckets
+// at a time. Insertion is O(1); extraction scans at most
+// (max_weight + 1) / 64 words and usually finds its bucket at once,
+// since the keys removed by Prim stay close to each other.
+// Every weight must be <= max_weight.
+// params: vertices, largest weight, root, adjacency, graph receiving
+// the tree.
+// return value: none.
+//===========================================
+template <class ForEach>
+void primBucket(const int V, const int max_weight, const int root, ForEach forEach, Graph &mst) {
+    if (root < 0 or root >= V)
+        throw std::invalid_argument("MST_Prim - Invalid Root");
+
+    const int buckets = std::max(max_weight, 0) + 1;
+    const int words = (buckets + 63) / 64;
+
+    std::vector<std::vector<std::pair<int, int>>> bucket(buckets);   //(tree vertex, new vertex)
+    std::vector<uint64_t> nonempty(words, 0);
+    std::vector<int> key(V, std::numeric_limits<int>::max());
+    std::vector<char> intree(V, 0);
+    int lowest = buckets;   //every bucket below lowest is empty
+
+    auto relax = [&](int u) {
+        forEach(u, [&](int v, int w) {
+            if (!intree[v] and w < key[v]) {
+                key[v] = w;
+                bucket[w].emplace_back(u, v);
+                nonempty[w >> 6] |= uint64_t(1) << (w & 63);
+                lowest = std::min(lowest, w);
+            }
+        });
+    };
+
+    intree[root] = 1;
+    relax(root);
+
+    while (lowest < buckets) {
+        //find the lightest non empty bucket, starting at lowest
+        int word = lowest >> 6;
+        uint64_t bits = nonempty[word] & (~uint64_t(0) << (lowest & 63));
+
+        while (bits == 0 and ++word < words)
+            bits = nonempty[word];
+        if (bits == 0)
+            break;
+
+        int w = (word << 6) + __builtin_ctzll(bits);
+        lowest = w;
+
+        auto uv = bucket[w].back();
+        bucket[w].pop_back();
+        if (bucket[w].empty())
+            nonempty[word] &= ~(uint64_t(1) << (w & 63));
+
+        int v = uv.second;
+        if (intree[v])      //stale entry, v was reached through a lighter edge
+            continue;
+
+        intree[v] = 1;
+        mst.insertTreeEdge(uv.first, v, w);
+        relax(v);
+    }
+}
+//===========================================
+// kruskal
+// Kruskal's algorithm over every edge of the adjacency.
+// params: vertices, adjacency, graph receiving the forest.
+// return value: none.
+//===========================================
+template <class ForEach>
+void kruskal(const int V, ForEach forEach, Graph &mst) {
+    std::priority_queue<std::tuple<int, int, int>, std::vector<std::tuple<int, int, int>>, Graph::sortbythird> pq;
+
+    for (int i = 0; i < V; ++i) {
+        forEach(i, [&](int v, int w) {
+            pq.push(std::make_tuple(i, v, w));
+        });
+    }
+    DSU S(V);
+    int count = 1;
+
+    while (!pq.empty() && count < V) {
+        auto uvw = pq.top();
+        pq.pop();
+
+        int u = std::get<0>(uvw);
+        int v = std::get<1>(uvw);
+
+        if (S.find_(u) != S.find_(v)) {
+            mst.insertTreeEdge(u, v, std::get<2>(uvw));
+            S.union_(u, v);
+            ++count;
+        }
+    }
+}
+
+#endif
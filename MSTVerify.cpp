@@ -0,0 +1,368 @@
+//================================================================
+// MSTVerify.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the MSTVerify.cpp file that implements the MST verifier.
+// For every non-tree edge (u, v) it needs the heaviest tree edge on
+// the path u .. v, found offline:
+//     pass 1  Tarjan's offline LCA gives the lowest common ancestor of
+//             every (u, v)
+//     pass 2  a second post-order walk links every vertex under its
+//             parent in a union-find that also keeps, for every link,
+//             the heaviest edge up to the representative. When x is
+//             finished its whole subtree has x as representative, so
+//             the queries whose LCA is x read their two path maxima.
+// The sensitivity of the tree edges comes from the non-tree edges in
+// increasing weight: each one is the replacement of every tree edge on
+// its path not covered by a lighter one, and a union-find jumps over
+// the tree edges already covered.
+//================================================================
+
+#include "MSTVerify.h"
+#include <algorithm>
+#include <tuple>
+#include <sstream>
+
+namespace {
+
+//Union-find keeping the heaviest edge between a vertex and its representative
+class PathMaxDSU {
+    private:
+        std::vector<int> parent;
+        std::vector<int> heaviest;     //heaviest edge up to parent, -1 if none
+        std::vector<int> path;
+    public:
+        PathMaxDSU(const int n) : parent(n), heaviest(n, -1) {
+            for (int i = 0; i < n; ++i)
+                parent[i] = i;
+        }
+
+        //links the representative x under p by an edge of weight w
+        void link(const int x, const int p, const int w) {
+            parent[x] = p;
+            heaviest[x] = w;
+        }
+
+        //heaviest edge between v and its representative, -1 if v is one
+        int maxToRoot(const int v) {
+            int root = v;
+            path.clear();
+            while (parent[root] != root) {
+                path.push_back(root);
+                root = parent[root];
+            }
+            //compress from the top, so each parent is already direct
+            for (size_t i = path.size(); i-- > 0; ) {
+                int x = path[i];
+                if (parent[x] != root) {
+                    heaviest[x] = std::max(heaviest[x], heaviest[parent[x]]);
+                    parent[x] = root;
+                }
+            }
+            return heaviest[v];
+        }
+};
+
+//Plain union-find with path compression, for the ancestor jumps
+int findJump(std::vector<int> &jump, int v) {
+    int root = v;
+    while (jump[root] != root)
+        root = jump[root];
+    while (jump[v] != root) {
+        int next = jump[v];
+        jump[v] = root;
+        v = next;
+    }
+    return root;
+}
+
+//Vertex lists in compressed rows, for the children and the queries
+struct Rows {
+    std::vector<int> offset;
+    std::vector<int> items;
+
+    void build(const int n, const std::vector<std::pair<int, int>> &pairs) {
+        offset.assign(n + 1, 0);
+        items.resize(pairs.size());
+        for (const auto& p : pairs)
+            offset[p.first + 1]++;
+        for (int i = 0; i < n; ++i)
+            offset[i + 1] += offset[i];
+        std::vector<int> next(offset.begin(), offset.end() - 1);
+        for (const auto& p : pairs)
+            items[next[p.first]++] = p.second;
+    }
+    const int* begin(const int v) const { return items.data() + offset[v]; }
+    const int* end(const int v) const { return items.data() + offset[v + 1]; }
+};
+
+//===========================================
+// postOrder
+// this method walks every tree of the forest depth first and calls
+// finish(x) once the children of x are done.
+// params: the roots, the children, the finish callback
+// return value: none.
+//===========================================
+template <class F>
+void postOrder(const std::vector<int> &roots, const Rows &children, F finish) {
+    std::vector<std::pair<int, const int*>> stack;
+
+    for (int r : roots) {
+        stack.emplace_back(r, children.begin(r));
+        while (!stack.empty()) {
+            int x = stack.back().first;
+            const int *&next = stack.back().second;
+
+            if (next != children.end(x)) {
+                int c = *next++;
+                stack.emplace_back(c, children.begin(c));
+                continue;
+            }
+            stack.pop_back();
+            finish(x);
+        }
+    }
+}
+
+std::string edgeString(const int v1, const int v2, const int w) {
+    std::ostringstream os;
+    os << "(" << v1 << "," << v2 << "," << w << ")";
+    return os.str();
+}
+
+}
+
+//===========================================
+// cout
+// this method prints the outcome of a verification.
+// params: ostream &os, the report
+// return value: a reference to the output stream.
+//===========================================
+std::ostream& operator<<(std::ostream &os, const MSTReport &r) {
+    if (r.valid)
+        os << "MST valid: mass " << r.mass << ", " << r.tree_edges << " tree edges, "
+           << r.checked_edges << " other edges checked";
+    else
+        os << "MST invalid: " << r.error;
+    return os;
+}
+//===========================================
+// verifyMST
+// this method checks the edge set of mst against the graph: every tree
+// edge must be an edge of the graph, the tree must have no cycle, must
+// connect whatever the graph connects, and must pass the cycle
+// property. Only the first problem is described in report.error, but
+// every violation of the cycle property is counted.
+// params: the graph, the tree, the report (output), whether to fill in
+//         the sensitivity
+// return value: none.
+//===========================================
+void verifyMST(const GraphView &graph, const Graph &mst, MSTReport &report, const bool sensitivity) {
+    const int V = graph.size();
+    report = MSTReport();
+
+    if (mst.size() != V) {
+        report.error = "the tree has " + std::to_string(mst.size()) + " vertices, the graph " + std::to_string(V);
+        return;
+    }
+
+    //edges of the graph as (min, max, w), without self-loops
+    std::vector<std::tuple<int, int, int>> edges;
+    for (int u = 0; u < V; ++u) {
+        const int *t = graph.targets(u);
+        const int *w = graph.weights(u);
+        for (int a = 0, d = graph.degree(u); a < d; ++a) {
+            #ifdef DIRECTED_GRAPH
+            if (t[a] != u)
+                edges.emplace_back(std::min(u, t[a]), std::max(u, t[a]), w[a]);
+            #else
+            if (t[a] > u)
+                edges.emplace_back(u, t[a], w[a]);
+            #endif
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    //tree edges: each must use up one copy of a graph edge
+    std::vector<char> in_tree(edges.size(), 0);
+    std::vector<std::tuple<int, int, int>> tree;
+    std::vector<std::pair<int, int>> adjacency;     //(vertex, tree edge)
+    ArrayDSU forest(V);
+
+    for (const auto& e : mst.getEdges()) {
+        int a = std::min(std::get<0>(e), std::get<1>(e));
+        int b = std::max(std::get<0>(e), std::get<1>(e));
+        int w = std::get<2>(e);
+
+        auto it = std::lower_bound(edges.begin(), edges.end(), std::make_tuple(a, b, w));
+        while (it != edges.end() and *it == std::make_tuple(a, b, w) and in_tree[it - edges.begin()])
+            ++it;
+        if (it == edges.end() or *it != std::make_tuple(a, b, w)) {
+            report.error = "tree edge " + edgeString(a, b, w) + " is not an edge of the graph";
+            return;
+        }
+        if (!forest.union_(a, b)) {
+            report.error = "tree edge " + edgeString(a, b, w) + " closes a cycle";
+            return;
+        }
+        in_tree[it - edges.begin()] = 1;
+        adjacency.emplace_back(a, (int)tree.size());
+        adjacency.emplace_back(b, (int)tree.size());
+        tree.emplace_back(a, b, w);
+        report.mass += w;
+    }
+    report.tree_edges = (int)tree.size();
+
+    //non-tree edges, which must not join two trees of the forest
+    std::vector<int> other;
+    for (size_t i = 0; i < edges.size(); ++i) {
+        if (in_tree[i])
+            continue;
+        if (forest.find_(std::get<0>(edges[i])) != forest.find_(std::get<1>(edges[i]))) {
+            report.error = "the tree does not span the graph: "
+                         + edgeString(std::get<0>(edges[i]), std::get<1>(edges[i]), std::get<2>(edges[i]))
+                         + " joins two of its components";
+            return;
+        }
+        other.push_back((int)i);
+    }
+    report.checked_edges = (int)other.size();
+
+    //root every tree of the forest
+    Rows incident;
+    incident.build(V, adjacency);
+    std::vector<int> parent(V, -1), up_weight(V, -1), depth(V, 0), roots;
+    std::vector<char> seen(V, 0);
+    std::vector<std::pair<int, int>> child_pairs;
+    std::vector<int> queue;
+
+    for (int r = 0; r < V; ++r) {
+        if (seen[r])
+            continue;
+        roots.push_back(r);
+        seen[r] = 1;
+        queue.assign(1, r);
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int x = queue[head];
+            for (const int *p = incident.begin(x); p != incident.end(x); ++p) {
+                const auto& e = tree[*p];
+                int y = (std::get<0>(e) == x) ? std::get<1>(e) : std::get<0>(e);
+                if (seen[y])
+                    continue;
+                seen[y] = 1;
+                parent[y] = x;
+                up_weight[y] = std::get<2>(e);
+                depth[y] = depth[x] + 1;
+                child_pairs.emplace_back(x, y);
+                queue.push_back(y);
+            }
+        }
+    }
+    Rows children;
+    children.build(V, child_pairs);
+
+    //pass 1: lowest common ancestors
+    std::vector<std::pair<int, int>> query_pairs;
+    for (size_t q = 0; q < other.size(); ++q) {
+        query_pairs.emplace_back(std::get<0>(edges[other[q]]), (int)q);
+        query_pairs.emplace_back(std::get<1>(edges[other[q]]), (int)q);
+    }
+    Rows queries;
+    queries.build(V, query_pairs);
+
+    std::vector<int> lca(other.size(), -1), ancestor(V);
+    std::vector<char> done(V, 0);
+    ArrayDSU below(V);
+    for (int v = 0; v < V; ++v)
+        ancestor[v] = v;
+
+    postOrder(roots, children, [&](const int x) {
+        done[x] = 1;
+        for (const int *q = queries.begin(x); q != queries.end(x); ++q) {
+            const auto& e = edges[other[*q]];
+            int y = (std::get<0>(e) == x) ? std::get<1>(e) : std::get<0>(e);
+            if (done[y])
+                lca[*q] = ancestor[below.find_(y)];
+        }
+        if (parent[x] != -1) {
+            below.union_(parent[x], x);
+            ancestor[below.find_(parent[x])] = parent[x];
+        }
+    });
+
+    //pass 2: path maxima, read at the LCA
+    std::vector<std::pair<int, int>> at_pairs;
+    for (size_t q = 0; q < other.size(); ++q)
+        at_pairs.emplace_back(lca[q], (int)q);
+    Rows at_lca;
+    at_lca.build(V, at_pairs);
+
+    std::vector<int> path_max(other.size(), -1);
+    PathMaxDSU up(V);
+
+    postOrder(roots, children, [&](const int x) {
+        for (const int *q = at_lca.begin(x); q != at_lca.end(x); ++q) {
+            const auto& e = edges[other[*q]];
+            path_max[*q] = std::max(up.maxToRoot(std::get<0>(e)), up.maxToRoot(std::get<1>(e)));
+        }
+        if (parent[x] != -1)
+            up.link(x, parent[x], up_weight[x]);
+    });
+
+    for (size_t q = 0; q < other.size(); ++q) {
+        const auto& e = edges[other[q]];
+        if (std::get<2>(e) < path_max[q]) {
+            if (report.violations++ == 0)
+                report.error = "edge " + edgeString(std::get<0>(e), std::get<1>(e), std::get<2>(e))
+                             + " is lighter than the tree edge of weight " + std::to_string(path_max[q])
+                             + " on its path";
+        }
+    }
+    report.valid = report.error.empty();
+
+    if (!sensitivity)
+        return;
+
+    //lightest non-tree edge covering each tree edge (named by its child)
+    std::vector<int> order(other.size());
+    for (size_t q = 0; q < other.size(); ++q)
+        order[q] = (int)q;
+    std::stable_sort(order.begin(), order.end(), [&](const int a, const int b) {
+        return std::get<2>(edges[other[a]]) < std::get<2>(edges[other[b]]);
+    });
+
+    std::vector<int> cover(V, -1);
+    std::vector<int> jump(V);
+    for (int v = 0; v < V; ++v)
+        jump[v] = v;
+
+    for (int q : order) {
+        const auto& e = edges[other[q]];
+        for (int x : {std::get<0>(e), std::get<1>(e)}) {
+            for (x = findJump(jump, x); depth[x] > depth[lca[q]]; x = findJump(jump, parent[x])) {
+                cover[x] = std::get<2>(e);
+                jump[x] = parent[x];
+            }
+        }
+    }
+
+    for (const auto& e : tree) {
+        int a = std::get<0>(e), b = std::get<1>(e), w = std::get<2>(e);
+        int c = (parent[a] == b) ? a : b;
+        report.sensitivity.push_back({a, b, w, true, cover[c] == -1 ? -1 : (long long)cover[c] - w});
+    }
+    for (size_t q = 0; q < other.size(); ++q) {
+        const auto& e = edges[other[q]];
+        report.sensitivity.push_back({std::get<0>(e), std::get<1>(e), std::get<2>(e), false,
+                                      (long long)std::get<2>(e) - path_max[q]});
+    }
+}
+//===========================================
+// verifyMST
+// this method verifies an MST against any backend.
+// params: Graph &g, the tree, the report (output), sensitivity or not
+// return value: none.
+//===========================================
+void verifyMST(const Graph &g, const Graph &mst, MSTReport &report, const bool sensitivity) {
+    verifyMST(GraphView(g), mst, report, sensitivity);
+}
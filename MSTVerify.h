@@ -0,0 +1,52 @@
+//================================================================
+// MSTVerify.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the MST verifier. A spanning
+// forest is minimal if and only if no edge outside it is lighter than
+// the heaviest edge of the tree path between its ends (the cycle
+// property). The path maxima of all the non-tree edges are found
+// offline, in two traversals of the tree with a union-find, so a
+// check costs about as much as one Kruskal pass without the sort.
+// The same pass gives the sensitivity of every edge:
+//     tree edge      how much it can grow before a non-tree edge
+//                    would replace it (the lightest edge covering it)
+//     non-tree edge  how much it can shrink before it would enter
+//                    the tree (its weight minus its path maximum)
+//================================================================
+
+#include "Graph.h"
+#include "GraphView.h"
+#include <vector>
+#include <string>
+#include <iostream>
+
+#ifndef MSTVERIFY_H
+#define MSTVERIFY_H
+
+struct EdgeSensitivity {
+    int v1;
+    int v2;
+    int w;
+    bool tree;
+    long long slack;    //change allowed before the MST changes, -1: any
+};
+
+struct MSTReport {
+    bool valid = false;
+    std::string error;      //first problem found, empty if valid
+    long long mass = 0;
+    int tree_edges = 0;
+    int checked_edges = 0;  //non-tree edges checked against their path
+    int violations = 0;     //non-tree edges lighter than their path maximum
+    std::vector<EdgeSensitivity> sensitivity;   //tree edges, then the others
+};
+
+std::ostream& operator<<(std::ostream &os, const MSTReport &r);
+
+//Checks that the edge set of mst is a minimum spanning forest of the
+//graph; with sensitivity the slack of every edge is filled in too
+void verifyMST(const GraphView &graph, const Graph &mst, MSTReport &report, const bool sensitivity = false);
+void verifyMST(const Graph &g, const Graph &mst, MSTReport &report, const bool sensitivity = false);
+
+#endif
@@ -0,0 +1,156 @@
+//================================================================
+// MultiSourceBFS.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the MultiSourceBFS.cpp file that implements the batched
+// BFS. For a batch of sources, bit j of a mask stands for source j:
+//     seen[v]  sources that have reached v
+//     visit[v] sources for which v is on the current frontier
+//     next[v]  sources reaching v in the next level
+// Each level pushes visit[v] to the neighbors of every frontier
+// vertex, then keeps in next[v] only the sources new to v. A vertex
+// shared by several frontiers is expanded once for all of them. The
+// frontier and the vertices touched are kept in lists, so a level
+// costs its own size even on long, thin graphs; once the frontier is
+// a sizable part of the graph, a sequential scan of all the vertices
+// is cheaper than the list and is used instead.
+//================================================================
+
+#include "MultiSourceBFS.h"
+#include "Parallel.h"
+#include <stdexcept>
+#include <algorithm>
+
+//===========================================
+// distance
+// this method returns the distance from source i to v.
+// params: source index i (in the order given), vertex v
+// return value: the distance, -1 if v is unreachable.
+//===========================================
+int MultiBFSResult::distance(const int i, const int v) const {
+    if (!hasDistances())
+        throw std::runtime_error("distance - Distances not kept");
+    if (i < 0 or i >= numSources() or v < 0 or v >= vert_count)
+        throw std::invalid_argument("distance - Invalid Index");
+
+    return dist[(size_t)i * vert_count + v];
+}
+//===========================================
+// mostDistant
+// this method lists the vertices farthest from source i.
+// params: source index i
+// return value: the vertices at distance eccentricity[i].
+//===========================================
+std::vector<int> MultiBFSResult::mostDistant(const int i) const {
+    std::vector<int> far;
+
+    for (int v = 0; v < vert_count; ++v) {
+        if (distance(i, v) == eccentricity[i])
+            far.push_back(v);
+    }
+    return far;
+}
+//===========================================
+// multiSourceBFS
+// this method runs the BFS of every source, MSBFS_BATCH at a time.
+// Each thread takes a block of batches with its own masks.
+// params: the view, the sources, the result (output), whether to keep
+//         the distance rows, thread count
+// return value: none.
+//===========================================
+void multiSourceBFS(const GraphView &view, const std::vector<int> &sources, MultiBFSResult &result,
+                    const bool keep_dist, const int threads) {
+    const int V = view.size();
+    const size_t k = sources.size();
+
+    for (int s : sources) {
+        if (s < 0 or s > V - 1)
+            throw std::invalid_argument("multiSourceBFS - source out of range");
+    }
+
+    result.vert_count = V;
+    result.sources = sources;
+    result.eccentricity.assign(k, 0);
+    result.reached.assign(k, 0);
+    result.total.assign(k, 0);
+    result.dist.assign(keep_dist ? k * V : 0, -1);
+
+    const size_t batches = (k + MSBFS_BATCH - 1) / MSBFS_BATCH;
+
+    const int T = (int)std::min<size_t>(std::max(1, threads), std::max<size_t>(batches, 1));
+
+    parallelFor(T, batches, [&](int, size_t lo, size_t hi) {
+        std::vector<uint64_t> seen(V), visit(V), next(V);
+        std::vector<int> frontier, touched;     //vertices with visit, next != 0
+
+        for (size_t b = lo; b < hi; ++b) {
+            const size_t base = b * MSBFS_BATCH;
+            const int count = (int)std::min<size_t>(MSBFS_BATCH, k - base);
+
+            std::fill(seen.begin(), seen.end(), 0);     //visit and next are left at 0
+
+            //records that the sources of mask reach v at level
+            auto discover = [&](const int v, uint64_t mask, const int level) {
+                while (mask != 0) {
+                    size_t i = base + __builtin_ctzll(mask);
+                    mask &= mask - 1;
+
+                    result.reached[i]++;
+                    result.total[i] += level;
+                    result.eccentricity[i] = level;
+                    if (keep_dist)
+                        result.dist[i * V + v] = level;
+                }
+            };
+
+            frontier.clear();
+            for (int j = 0; j < count; ++j) {
+                int s = sources[base + j];
+                if (visit[s] == 0)
+                    frontier.push_back(s);
+                seen[s] |= 1ULL << j;
+                visit[s] |= 1ULL << j;
+                discover(s, 1ULL << j, 0);
+            }
+
+            for (int level = 1; !frontier.empty(); ++level) {
+                const bool wide = frontier.size() > (size_t)V / MSBFS_WIDE_FRONTIER;
+
+                touched.clear();
+                for (int v : frontier) {
+                    uint64_t mask = visit[v];
+                    visit[v] = 0;
+
+                    const int *t = view.targets(v);
+                    for (int a = 0, d = view.degree(v); a < d; ++a) {
+                        if (!wide and next[t[a]] == 0)
+                            touched.push_back(t[a]);
+                        next[t[a]] |= mask;
+                    }
+                }
+
+                auto settle = [&](const int v) {
+                    uint64_t fresh = next[v] & ~seen[v];
+                    next[v] = 0;
+
+                    if (fresh != 0) {
+                        seen[v] |= fresh;
+                        visit[v] = fresh;
+                        frontier.push_back(v);
+                        discover(v, fresh, level);
+                    }
+                };
+
+                frontier.clear();
+                if (wide) {
+                    for (int v = 0; v < V; ++v)
+                        settle(v);
+                }
+                else {
+                    for (int v : touched)
+                        settle(v);
+                }
+            }
+        }
+    });
+}
@@ -0,0 +1,44 @@
+//================================================================
+// MultiSourceBFS.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the multi-source BFS. Up to 64
+// sources share one traversal (MS-BFS): every vertex keeps a 64-bit
+// mask of the sources that have seen it, and a frontier vertex pushes
+// its whole mask to its neighbors at once. A graph is thus scanned
+// once per level for 64 sources, instead of once per source, and the
+// per-vertex state is three words instead of a BFS table per source.
+//================================================================
+
+#include "GraphView.h"
+#include <vector>
+#include <cstdint>
+
+#ifndef MULTISOURCEBFS_H
+#define MULTISOURCEBFS_H
+
+const int MSBFS_BATCH = 64;     //sources per traversal, one bit each
+const int MSBFS_WIDE_FRONTIER = 32;     //scan every vertex when the frontier is above V / this
+
+//Results per source, in the order of the sources given
+struct MultiBFSResult {
+    int vert_count = 0;
+    std::vector<int> sources;
+    std::vector<int> eccentricity;  //largest distance to a reached vertex
+    std::vector<int> reached;       //vertices reached, the source included
+    std::vector<long long> total;   //sum of the distances to reached vertices
+    std::vector<int> dist;          //dist[i * V + v], -1 if unreachable (only if kept)
+
+    int     numSources  (void) const { return (int)sources.size(); }
+    bool    hasDistances(void) const { return !dist.empty(); }
+    int     distance    (const int i, const int v) const;
+    //Vertices at the eccentricity of source i (as printMostDistant)
+    std::vector<int> mostDistant(const int i) const;
+};
+
+//Runs a BFS from every source, in batches of MSBFS_BATCH, batches
+//spread over the threads. keep_dist stores the full distance rows.
+void multiSourceBFS(const GraphView &view, const std::vector<int> &sources, MultiBFSResult &result,
+                    const bool keep_dist = false, const int threads = 1);
+
+#endif
@@ -0,0 +1,70 @@
+//================================================================
+// Parallel.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file holds the small threading helpers shared by the parallel
+// algorithms: a default thread count and a parallel for loop that
+// splits [0, n) into one contiguous block per thread.
+//================================================================
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <exception>
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+//===========================================
+// defaultThreads
+// this method returns the number of hardware threads (at least 1).
+// params: none
+// return value: thread count.
+//===========================================
+inline int defaultThreads(void) {
+    unsigned n = std::thread::hardware_concurrency();
+    return n > 0 ? (int)n : 1;
+}
+//===========================================
+// parallelFor
+// this method calls f(t, lo, hi) for blocks [lo, hi) of [0, n), block
+// t on thread t. Blocks are contiguous and in order, so block t holds
+// the items before those of block t + 1. The first exception thrown by
+// a block is rethrown once every thread has finished.
+// params: thread count, number of items, the block function.
+// return value: none.
+//===========================================
+template <class F>
+void parallelFor(int threads, const size_t n, F f) {
+    threads = std::max(1, threads);
+
+    if (threads == 1) {
+        f(0, (size_t)0, n);
+        return;
+    }
+
+    std::vector<std::thread> pool;
+    std::vector<std::exception_ptr> errors(threads);
+
+    for (int t = 0; t < threads; ++t) {
+        size_t lo = n * t / threads;
+        size_t hi = n * (t + 1) / threads;
+
+        pool.emplace_back([&f, &errors, t, lo, hi]() {
+            try {
+                f(t, lo, hi);
+            }
+            catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    for (auto& th : pool)
+        th.join();
+    for (auto& e : errors) {
+        if (e)
+            std::rethrow_exception(e);
+    }
+}
+
+#endif
@@ -0,0 +1,322 @@
+//================================================================
+// ParallelBuild.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the ParallelBuild.cpp file that implements the parallel
+// parser and the parallel adjacency layout.
+// Parsing: the stream is read a fixed-size block at a time, cut after
+// its last whitespace (the rest is kept for the next block). Each block
+// is cut at whitespace into one chunk per thread and each thread turns
+// its chunk into integers. The chunks are in order, so concatenating
+// their integers gives the token stream operator>> would read. Errors
+// are only reported if they fall inside the first 3 * E tokens, the
+// ones operator>> would have looked at, and reading stops once those
+// are in.
+// Layout: thread t buckets the arcs of its block of edges by the
+// thread owning their row, into one slice per (owner, thread). Owner u
+// then reads slices 0 .. T-1 in turn: every arc is handled twice in
+// all, and u sees the arcs of its rows in input order, as insertEdge
+// adds them, while it counts, lays out and fills those rows.
+//================================================================
+
+#include "ParallelBuild.h"
+#include "Parallel.h"
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+bool isSpace(const char c) {
+    return c == ' ' or c == '\n' or c == '\t' or c == '\r' or c == '\v' or c == '\f';
+}
+
+//Integers of one chunk, and where parsing stopped if it hit a bad token
+struct Chunk {
+    std::vector<int> tokens;
+    bool bad = false;
+};
+
+//===========================================
+// parseChunk
+// this method reads the integers of [p, end) into chunk. A token that
+// is not an integer (or overflows an int) stops the chunk, as it would
+// stop operator>>.
+// params: the text range, the chunk to fill.
+// return value: none.
+//===========================================
+void parseChunk(const char *p, const char *end, Chunk &chunk) {
+    while (true) {
+        while (p < end and isSpace(*p))
+            ++p;
+        if (p == end)
+            return;
+
+        bool negative = false;
+        if (*p == '-' or *p == '+')
+            negative = (*p++ == '-');
+
+        if (p == end or *p < '0' or *p > '9') {
+            chunk.bad = true;
+            return;
+        }
+
+        long long x = 0;
+        while (p < end and *p >= '0' and *p <= '9') {
+            x = 10 * x + (*p++ - '0');
+            if (x > (long long)std::numeric_limits<int>::max() + 1) {
+                chunk.bad = true;
+                return;
+            }
+        }
+        x = negative ? -x : x;
+        if (x > std::numeric_limits<int>::max()) {
+            chunk.bad = true;
+            return;
+        }
+        chunk.tokens.push_back((int)x);
+    }
+}
+//Edges parsed so far, from blocks of text fed in order
+class EdgeParser {
+    private:
+        size_t wanted;          //3 * E: the tokens operator>> would read
+        size_t taken;
+        std::vector<int> partial;   //tokens of an edge cut by a block end
+
+    public:
+        std::vector<std::tuple<int, int, int>> edge_list;
+        bool done;
+
+        EdgeParser(const int E) : wanted(3 * (size_t)std::max(E, 0)), taken(0), done(wanted == 0) {}
+
+        void feed(const char *begin, const char *end, const int threads);
+};
+//===========================================
+// feed
+// this method parses the block [begin, end), which must end at a token
+// boundary, and appends its edges. A bad token within the first 3 * E
+// tokens is an error; after them it ends the list.
+// params: the text range, thread count
+// return value: none.
+//===========================================
+void EdgeParser::feed(const char *begin, const char *end, const int threads) {
+    const int T = std::max(1, threads);
+    const size_t len = end - begin;
+
+    //chunk t starts at the first token boundary at or after len * t / T
+    std::vector<const char*> cut(T + 1, end);
+    cut[0] = begin;
+    for (int t = 1; t < T; ++t) {
+        const char *p = std::max(begin + len * t / T, cut[t - 1]);
+        while (p > begin and p < end and !isSpace(*(p - 1)))
+            ++p;
+        cut[t] = p;
+    }
+
+    std::vector<Chunk> chunks(T);
+    parallelFor(T, T, [&](int, size_t lo, size_t hi) {
+        for (size_t t = lo; t < hi; ++t)
+            parseChunk(cut[t], cut[t + 1], chunks[t]);
+    });
+
+    //place every chunk in the token stream, up to the first bad token
+    std::vector<size_t> start(T + 1, 0);
+    int last = T;
+    for (int t = 0; t < T; ++t) {
+        start[t + 1] = start[t] + chunks[t].tokens.size();
+        if (chunks[t].bad) {
+            if (taken + start[t + 1] < wanted)
+                throw std::runtime_error("operator>> - Error reading edge data");
+            last = t + 1;
+            done = true;
+            break;
+        }
+    }
+
+    size_t tokens = std::min(start[last], wanted - taken);
+    taken += tokens;
+    done = done or taken == wanted;
+
+    //the cut edge first, then the tokens of the block
+    const size_t carried = partial.size();
+    std::vector<int> flat(carried + tokens);
+    std::copy(partial.begin(), partial.end(), flat.begin());
+
+    parallelFor(T, last, [&](int, size_t lo, size_t hi) {
+        for (size_t t = lo; t < hi; ++t) {
+            for (size_t i = 0; i < chunks[t].tokens.size() and start[t] + i < tokens; ++i)
+                flat[carried + start[t] + i] = chunks[t].tokens[i];
+        }
+    });
+
+    size_t n = flat.size() / 3;
+    size_t first = edge_list.size();
+    edge_list.resize(first + n);
+    parallelFor(T, n, [&](int, size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i)
+            edge_list[first + i] = std::make_tuple(flat[3 * i], flat[3 * i + 1], flat[3 * i + 2]);
+    });
+    partial.assign(flat.begin() + 3 * n, flat.end());
+}
+
+}
+
+//===========================================
+// readEdgesParallel
+// this method reads the rest of the stream a block of chunk bytes at a
+// time and parses it, stopping once E edges are in.
+// params: istream &is, edges in the header, thread count, block size
+// return value: the edges, in input order.
+//===========================================
+std::vector<std::tuple<int, int, int>> readEdgesParallel(std::istream &is, const int E, const int threads,
+                                                         const size_t chunk) {
+    EdgeParser parser(E);
+    std::vector<char> text;     //the rest of the last block, then the next one
+
+    while (!parser.done) {
+        size_t kept = text.size();
+        text.resize(kept + std::max(chunk, (size_t)1));
+        is.read(text.data() + kept, text.size() - kept);
+        text.resize(kept + is.gcount());
+
+        const bool last = !is;
+        size_t cut = text.size();
+        if (!last) {
+            //up to the last whitespace; with none, the block is one token so far
+            while (cut > 0 and !isSpace(text[cut - 1]))
+                --cut;
+            if (cut == 0)
+                continue;
+        }
+        parser.feed(text.data(), text.data() + cut, threads);
+        text.erase(text.begin(), text.begin() + cut);
+        if (last)
+            break;
+    }
+    if (is.eof())
+        is.clear(std::ios::eofbit);
+    return std::move(parser.edge_list);
+}
+//===========================================
+// parseEdgesParallel
+// this method parses up to E "v1 v2 w" edges from [begin, end). As
+// with operator>>, a missing or partial edge at the end of the text
+// ends the list without an error.
+// params: the text range, edges in the header, thread count
+// return value: the edges, in input order.
+//===========================================
+std::vector<std::tuple<int, int, int>> parseEdgesParallel(const char *begin, const char *end, const int E, const int threads) {
+    EdgeParser parser(E);
+
+    if (!parser.done)
+        parser.feed(begin, end, threads);
+    return std::move(parser.edge_list);
+}
+//===========================================
+// buildAdjacency
+// this method checks the edges and lays out the rows in parallel.
+// The first invalid edge in input order is reported with the message
+// insertEdge would have given.
+// params: vertices, the edges, thread count
+// return value: the adjacency.
+//===========================================
+Adjacency buildAdjacency(const int V, const std::vector<std::tuple<int, int, int>> &edge_list, const int threads) {
+    if (V < 0)
+        throw std::invalid_argument("buildAdjacency - Invalid Size");
+
+    const int T = std::max(1, threads);
+    const size_t n = edge_list.size();
+    const size_t NONE = std::numeric_limits<size_t>::max();
+
+    std::vector<size_t> bad_vertex(T, NONE);
+    std::vector<size_t> bad_weight(T, NONE);
+
+    parallelFor(T, n, [&](int t, size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            int v1 = std::get<0>(edge_list[i]);
+            int v2 = std::get<1>(edge_list[i]);
+
+            if (v1 >= V or v2 >= V or v1 < 0 or v2 < 0) {
+                bad_vertex[t] = i;
+                return;
+            }
+            if (std::get<2>(edge_list[i]) < 0) {
+                bad_weight[t] = i;
+                return;
+            }
+        }
+    });
+    for (int t = 0; t < T; ++t) {
+        if (bad_vertex[t] != NONE)
+            throw std::invalid_argument("insertEdge - Invalid Vertices");
+        if (bad_weight[t] != NONE)
+            throw std::invalid_argument("insertEdge - Invalid Weight");
+    }
+
+    //owner of row v: the block of parallelFor(T, V, ...) holding v
+    auto owner = [V, T](const int v) {
+        return (int)(((size_t)(v + 1) * T - 1) / V);
+    };
+
+    //slice[u * T + t]: start of the arcs of rows of u found by thread t
+    std::vector<size_t> slice(T * T + 1, 0);
+
+    parallelFor(T, n, [&](int t, size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            slice[owner(std::get<0>(edge_list[i])) * T + t + 1]++;
+            #ifndef DIRECTED_GRAPH
+            slice[owner(std::get<1>(edge_list[i])) * T + t + 1]++;
+            #endif
+        }
+    });
+    for (int s = 0; s < T * T; ++s)
+        slice[s + 1] += slice[s];
+
+    //(row, neighbor, weight), grouped by owner and then by thread
+    std::vector<std::tuple<int, int, int>> bucket(slice[T * T]);
+
+    parallelFor(T, n, [&](int t, size_t lo, size_t hi) {
+        std::vector<size_t> next(T);
+        for (int u = 0; u < T; ++u)
+            next[u] = slice[u * T + t];
+
+        for (size_t i = lo; i < hi; ++i) {
+            int v1 = std::get<0>(edge_list[i]);
+            int v2 = std::get<1>(edge_list[i]);
+            int w = std::get<2>(edge_list[i]);
+
+            bucket[next[owner(v1)]++] = std::make_tuple(v1, v2, w);
+            #ifndef DIRECTED_GRAPH
+            bucket[next[owner(v2)]++] = std::make_tuple(v2, v1, w);
+            #endif
+        }
+    });
+
+    //the rows of u come after the arcs of the owners before it
+    Adjacency adj;
+    adj.offset.assign(V + 1, 0);
+    adj.arcs.resize(slice[T * T]);
+
+    parallelFor(T, V, [&](int u, size_t lo, size_t hi) {
+        const size_t first = slice[u * T];
+        const size_t last = slice[(u + 1) * T];
+
+        for (size_t a = first; a < last; ++a)
+            adj.offset[std::get<0>(bucket[a]) + 1]++;
+
+        std::vector<size_t> next(hi - lo);
+        size_t running = first;
+        for (size_t v = lo; v < hi; ++v) {
+            next[v - lo] = running;
+            running += adj.offset[v + 1];
+            adj.offset[v + 1] = running;
+        }
+
+        for (size_t a = first; a < last; ++a) {
+            int v = std::get<0>(bucket[a]);
+            adj.arcs[next[v - lo]++] = std::make_pair(std::get<1>(bucket[a]), std::get<2>(bucket[a]));
+        }
+    });
+    return adj;
+}
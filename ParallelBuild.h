@@ -0,0 +1,39 @@
+//================================================================
+// ParallelBuild.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the parallel graph construction.
+// The text of the edge list is split in chunks parsed by different
+// threads, and the adjacency is laid out by bucketing the arcs by the
+// thread owning their row, then counting and scattering each bucket,
+// instead of one insertEdge call per edge. Every step keeps the input order, so the graph built is
+// the same as with serial insertion.
+//================================================================
+
+#include <vector>
+#include <tuple>
+#include <string>
+#include <iostream>
+
+#ifndef PARALLELBUILD_H
+#define PARALLELBUILD_H
+
+//Adjacency in compressed rows: the arcs of v are [offset[v], offset[v+1])
+struct Adjacency {
+    std::vector<size_t> offset;
+    std::vector<std::pair<int, int>> arcs;     //(neighbor, weight) in insertion order
+};
+
+//Text read and parsed at a time by readEdgesParallel
+const size_t PARSE_CHUNK_BYTES = 1 << 26;
+
+//Reads up to E edges from the rest of the stream, as operator>> would
+std::vector<std::tuple<int, int, int>> readEdgesParallel(std::istream &is, const int E, const int threads,
+                                                         const size_t chunk = PARSE_CHUNK_BYTES);
+std::vector<std::tuple<int, int, int>> parseEdgesParallel(const char *begin, const char *end, const int E, const int threads);
+
+//Checks the edges like insertEdge and lays out both directions of each
+//(one unless DIRECTED_GRAPH is defined)
+Adjacency buildAdjacency(const int V, const std::vector<std::tuple<int, int, int>> &edge_list, const int threads);
+
+#endif
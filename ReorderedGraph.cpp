@@ -0,0 +1,345 @@
+//================================================================
+// ReorderedGraph.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the ReorderedGraph.cpp file that implements the vertex
+// orderings and the ReorderedGraph class. Vertex ids coming from the
+// input file are arbitrary, so the neighbors of a vertex are spread
+// over the whole of the per-vertex arrays. Relabeling the vertices so
+// that neighbors get close ids keeps the color/dist/pred accesses of
+// BFS, DFS and Prim in a few cache lines.
+// Results map back exactly: adjacency lists keep their order and the
+// traversals start from the same (relabeled) vertices. MST_Kruskal
+// scans the vertices in relabeled order, so with equal weights it may
+// pick a different (equally light) tree than the SparseGraph does.
+//================================================================
+
+#include "ReorderedGraph.h"
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+#include <queue>
+
+//===========================================
+// computeOrdering
+// this method computes the relabeling of the vertices of g.
+//   BFS:    breadth first order, components taken by smallest id.
+//   RCM:    reverse Cuthill-McKee, each component started from its
+//           vertex of smallest degree, neighbors by increasing degree.
+//   DEGREE: vertices by decreasing degree (hubs first).
+//   NONE:   identity.
+// params: SparseGraph &g, the ordering.
+// return value: the permutation, perm[old] = new.
+//===========================================
+std::vector<int> computeOrdering(const SparseGraph &g, const Ordering o) {
+    const int V = g.size();
+    std::vector<int> order;     //order[new] = old
+    order.reserve(V);
+
+    auto degree = [&g](int v) { return (int)g.neighbors(v).size(); };
+
+    if (o == Ordering::NONE) {
+        for (int v = 0; v < V; ++v)
+            order.push_back(v);
+    }
+    else if (o == Ordering::DEGREE) {
+        for (int v = 0; v < V; ++v)
+            order.push_back(v);
+        std::stable_sort(order.begin(), order.end(),
+                         [&degree](int a, int b) { return degree(a) > degree(b); });
+    }
+    else {
+        std::vector<char> visited(V, 0);
+        std::vector<int> starts;
+        std::vector<int> fringe;
+
+        for (int v = 0; v < V; ++v)
+            starts.push_back(v);
+        if (o == Ordering::RCM)
+            std::stable_sort(starts.begin(), starts.end(),
+                             [&degree](int a, int b) { return degree(a) < degree(b); });
+
+        for (int s : starts) {
+            if (visited[s])
+                continue;
+
+            size_t head = order.size();
+            visited[s] = 1;
+            order.push_back(s);
+
+            while (head < order.size()) {
+                int u = order[head++];
+
+                fringe.clear();
+                for (const auto& edge : g.neighbors(u)) {
+                    if (!visited[edge.first]) {
+                        visited[edge.first] = 1;
+                        fringe.push_back(edge.first);
+                    }
+                }
+                if (o == Ordering::RCM)
+                    std::stable_sort(fringe.begin(), fringe.end(),
+                                     [&degree](int a, int b) { return degree(a) < degree(b); });
+                order.insert(order.end(), fringe.begin(), fringe.end());
+            }
+        }
+        if (o == Ordering::RCM)
+            std::reverse(order.begin(), order.end());
+    }
+
+    std::vector<int> perm(V);
+    for (int n = 0; n < V; ++n)
+        perm[order[n]] = n;
+    return perm;
+}
+//===========================================
+// parseOrdering
+// this method converts a name (none, bfs, rcm, degree) to an ordering.
+// params: the name.
+// return value: the ordering.
+//===========================================
+Ordering parseOrdering(const std::string &name) {
+    if (name == "none")     return Ordering::NONE;
+    if (name == "bfs")      return Ordering::BFS;
+    if (name == "rcm")      return Ordering::RCM;
+    if (name == "degree")   return Ordering::DEGREE;
+    throw std::invalid_argument("parseOrdering - Unknown Ordering " + name);
+}
+
+std::string toString(const Ordering o) {
+    switch (o) {
+        case Ordering::BFS:     return "bfs";
+        case Ordering::RCM:     return "rcm";
+        case Ordering::DEGREE:  return "degree";
+        default:                return "none";
+    }
+}
+//===========================================
+// Constructor
+// this method relabels a copy of g with the requested ordering.
+// params: SparseGraph &g, the ordering.
+// return value: none
+//===========================================
+ReorderedGraph::ReorderedGraph(const SparseGraph &g, const Ordering o) : \
+    Graph(g.size(), g.numEdges()), perm(computeOrdering(g, o)), inv(g.size()), inner(nullptr) {
+    for (int v = 0; v < vert_count; ++v)
+        inv[perm[v]] = v;
+
+    inner = g.relabel(perm);
+    edges = g.getEdges();
+    max_weight = g.maxWeight();
+}
+//===========================================
+// Destructor
+//===========================================
+ReorderedGraph::~ReorderedGraph(void) {
+    delete inner;
+}
+//===========================================
+// isEdge
+// this method returns true if there is an edge from v1 to v2.
+// params: two vertices - v1, v2 (original ids).
+// return value: boolean value
+//===========================================
+bool ReorderedGraph::isEdge(const int v1, const int v2) const {
+    if (v1 >= vert_count or v2 >= vert_count or v1 < 0 or v2 < 0)
+        throw std::invalid_argument("isEdge - Invalid Vertices");
+
+    return inner->isEdge(perm[v1], perm[v2]);
+}
+//===========================================
+// getWeight
+// this method returns the weight of the edge from v1 to v2, -1 if
+// there is no such edge.
+// params: two vertices - v1, v2 (original ids).
+// return value: the weight.
+//===========================================
+int ReorderedGraph::getWeight(const int v1, const int v2) const {
+    if (v1 >= vert_count or v2 >= vert_count or v1 < 0 or v2 < 0)
+        throw std::invalid_argument("getWeight - Invalid Vertices");
+
+    return inner->getWeight(perm[v1], perm[v2]);
+}
+//===========================================
+// getNeighbors
+// this method lists the neighbors of v, with original ids.
+// params: vertex v (original id), the vector receiving the pairs.
+// return value: none.
+//===========================================
+void ReorderedGraph::getNeighbors(const int v, std::vector<std::pair<int,int>> &out) const {
+    if (v >= vert_count or v < 0)
+        throw std::invalid_argument("getNeighbors - Invalid Vertex");
+
+    out.clear();
+    for (const auto& edge : inner->neighbors(perm[v]))
+        out.emplace_back(inv[edge.first], edge.second);
+}
+//===========================================
+// insertEdge
+// this method inserts a new edge into the graph.
+// params: two vertices - v1, v2 (original ids) and the weight value.
+// return value: none.
+//===========================================
+void ReorderedGraph::insertEdge(const int v1, const int v2, int w) {
+    if (v1 >= vert_count or v2 >= vert_count or v1 < 0 or v2 < 0)
+        throw std::invalid_argument("insertEdge - Invalid Vertices");
+
+    inner->insertEdge(perm[v1], perm[v2], w);
+    edges.insert(std::make_tuple(v1, v2, w));
+    max_weight = inner->maxWeight();
+
+    #ifndef DIRECTED_GRAPH
+    edges.insert(std::make_tuple(v2, v1, w));
+    #endif
+}
+//===========================================
+// toOriginal
+// this method reorders a table column from relabeled ids to original
+// ids. Columns that hold vertex ids (pred) have their values mapped too.
+// params: the column, whether it holds vertex ids.
+// return value: none.
+//===========================================
+void ReorderedGraph::toOriginal(std::vector<int> &column, const bool holds_ids) const {
+    std::vector<int> mapped(vert_count);
+
+    for (int v = 0; v < vert_count; ++v) {
+        int x = column[perm[v]];
+        mapped[v] = (holds_ids and x >= 0) ? inv[x] : x;
+    }
+    column.swap(mapped);
+}
+//===========================================
+// BFS
+// breadth first search on the relabeled graph. The table is filled
+// by relabeled id and mapped back once at the end.
+// params: source vertex (original id)
+// return value: none.
+//===========================================
+void ReorderedGraph::BFS(int source) {
+    if (source < 0 or source > vert_count - 1)
+        throw std::invalid_argument("BFS - source out of range");
+
+    std::vector<int> &color = table["color"];
+    std::vector<int> &dist = table["dist"];
+    std::vector<int> &pred = table["pred"];
+
+    color.assign(vert_count, 0); //0: W, 1: G, 2: B
+    dist.assign(vert_count, std::numeric_limits<int>::infinity());
+    pred.assign(vert_count, -1); //-1: NIL
+
+    int s = perm[source];
+    color[s] = 1;
+    dist[s] = 0;
+
+    std::queue<int> Q;
+    Q.push(s);
+
+    while (!Q.empty()) {
+        int u = Q.front();
+        Q.pop();
+
+        for (const auto& edge : inner->neighbors(u)) {
+            if (color[edge.first] == 0) {
+                color[edge.first] = 1;
+                dist[edge.first] = dist[u] + 1;
+                pred[edge.first] = u;
+                Q.push(edge.first);
+            }
+        }
+        color[u] = 2;
+    }
+    toOriginal(color, false);
+    toOriginal(dist, false);
+    toOriginal(pred, true);
+}
+//===========================================
+// DFS
+// depth first search on the relabeled graph. The roots are taken in
+// original id order so the discovery/finish times match the
+// SparseGraph ones.
+// params: none.
+// return value: none.
+//===========================================
+void ReorderedGraph::DFS(void) {
+    dfs_edges.clear();
+
+    table["color"].assign(vert_count, 0); //0: W, 1: G, 2: B
+    table["pred"].assign(vert_count, -1); //-1: NIL
+    table["disc"].assign(vert_count, -1);
+    table["f"].assign(vert_count, -1);
+
+    int time = 0;
+    for (int i = 0; i < vert_count; ++i) {
+        if (table["color"][perm[i]] == 0)
+            DFS_Visit(perm[i], time);
+    }
+
+    toOriginal(table["color"], false);
+    toOriginal(table["pred"], true);
+    toOriginal(table["disc"], false);
+    toOriginal(table["f"], false);
+    for (auto& edge : dfs_edges)
+        edge = std::make_pair(inv[edge.first], inv[edge.second]);
+}
+//===========================================
+// DFS_Visit
+// helper for DFS, works on relabeled ids.
+// params: int v (relabeled id) and clock time.
+// return value: none.
+//===========================================
+void ReorderedGraph::DFS_Visit(int v, int &clock) {
+    clock++;
+
+    table["disc"][v] = clock;
+    table["color"][v] = 1;
+
+    for (const auto& edge : inner->neighbors(v)) {
+        dfs_edges.emplace_back(std::make_pair(v, edge.first));
+
+        if (table["color"][edge.first] == 0) {
+            table["pred"][edge.first] = v;
+            DFS_Visit(edge.first, clock);
+        }
+    }
+    clock++;
+    table["f"][v] = clock;
+    table["color"][v] = 2;
+}
+//===========================================
+// mapBack
+// this method builds a copy of an MST of the relabeled graph with the
+// original vertex ids.
+// params: the MST of the relabeled graph.
+// return value: pointer to the MST (owned by the caller).
+//===========================================
+SparseGraph* ReorderedGraph::mapBack(const SparseGraph *mst) const {
+    SparseGraph* mst_graph = new SparseGraph(vert_count, 0);
+
+    for (const auto& e : mst->getEdges())
+        mst_graph->insertTreeEdge(inv[std::get<0>(e)], inv[std::get<1>(e)], std::get<2>(e));
+    return mst_graph;
+}
+//===========================================
+// MST_Prim
+// Prim on the relabeled graph, grown from (relabeled) vertex 0.
+// params: none.
+// return value: pointer to the MST (owned by the caller).
+//===========================================
+SparseGraph* ReorderedGraph::MST_Prim(void) {
+    SparseGraph* mst = inner->MST_Prim(vert_count > 0 ? perm[0] : 0);
+    SparseGraph* mst_graph = mapBack(mst);
+    delete mst;
+    return mst_graph;
+}
+//===========================================
+// MST_Kruskal
+// Kruskal on the relabeled graph.
+// params: none.
+// return value: pointer to the MST (owned by the caller).
+//===========================================
+SparseGraph* ReorderedGraph::MST_Kruskal(void) {
+    SparseGraph* mst = inner->MST_Kruskal();
+    SparseGraph* mst_graph = mapBack(mst);
+    delete mst;
+    return mst_graph;
+}
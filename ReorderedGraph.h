@@ -0,0 +1,62 @@
+//================================================================
+// ReorderedGraph.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the ReorderedGraph class. A
+// ReorderedGraph wraps a SparseGraph whose vertices have been
+// relabeled for locality (BFS order, reverse Cuthill-McKee or degree
+// order). The algorithms run on the relabeled copy and every result
+// (tables, DFS edges, MSTs) is mapped back to the original vertex
+// ids, so the printed output is the same as for the SparseGraph.
+//================================================================
+
+#include "Graph.h"
+#include "SparseGraph.h"
+#include <vector>
+#include <string>
+
+#ifndef REORDEREDGRAPH_H
+#define REORDEREDGRAPH_H
+
+enum class Ordering { NONE, BFS, RCM, DEGREE };
+
+//perm[old] = new for the requested ordering
+std::vector<int>    computeOrdering (const SparseGraph &g, const Ordering o);
+Ordering            parseOrdering   (const std::string &name);
+std::string         toString        (const Ordering o);
+
+class ReorderedGraph : public Graph {
+    private:
+        std::vector<int> perm;  //original id -> relabeled id
+        std::vector<int> inv;   //relabeled id -> original id
+        SparseGraph *inner;     //the relabeled graph
+
+        //maps a table column indexed by relabeled ids back to original ids
+        void toOriginal(std::vector<int> &column, const bool holds_ids) const;
+        SparseGraph* mapBack(const SparseGraph *mst) const;
+    public:
+        ReorderedGraph(const SparseGraph &g, const Ordering o);
+        ReorderedGraph(const ReorderedGraph &other) = delete;
+        ReorderedGraph& operator=(const ReorderedGraph &other) = delete;
+        ~ReorderedGraph(void);
+
+        //Basic functions (original ids)
+        void insertEdge(const int v1, const int v2, int w) override;
+        bool isEdge(const int v1, const int v2) const override;
+        int getWeight(const int v1, const int v2) const override;
+        void getNeighbors(const int v, std::vector<std::pair<int,int>> &out) const override;
+
+        //BFS-based Algorithms
+        void BFS(int source) override;
+
+        //DFS-based Algorithms
+        void DFS(void) override;
+        void DFS_Visit(int v, int &clock) override;   //v is a relabeled id
+
+        SparseGraph*    MST_Prim (void) override;
+        SparseGraph*    MST_Kruskal (void) override;
+
+        const std::vector<int>& permutation(void) const { return perm; }
+};
+
+#endif
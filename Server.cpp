@@ -0,0 +1,609 @@
+//================================================================
+// Server.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the Server.cpp file that implements the MST job server. Each
+// connection has two threads: the reader parses the requests, submits
+// the jobs and queues one answer per request; the writer takes the
+// answers in order, waits for their job and sends them. So a slow MST
+// holds back only the answers queued behind it on its own connection.
+//================================================================
+
+#include "Server.h"
+#include "GraphIO.h"
+#include "EdgeIngest.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+
+namespace {
+
+//Buffered reads of lines and integers from a socket
+class SocketReader {
+    private:
+        int fd;
+        char buf[1 << 16];
+        size_t pos;
+        size_t len;
+
+        bool fill(void) {
+            pos = 0;
+            while (true) {
+                ssize_t n = ::read(fd, buf, sizeof(buf));
+                if (n < 0 and errno == EINTR)
+                    continue;
+                len = n > 0 ? (size_t)n : 0;
+                return n > 0;
+            }
+        }
+
+    public:
+        SocketReader(const int f) : fd(f), pos(0), len(0) {}
+
+        //next line without the '\n' (and '\r'), false at the end
+        bool line(std::string &out) {
+            out.clear();
+            while (true) {
+                if (pos == len and !fill())
+                    return !out.empty();
+                char *end = (char*)std::memchr(buf + pos, '\n', len - pos);
+                size_t n = (end ? end - buf : len) - pos;
+                out.append(buf + pos, n);
+                pos += n;
+                if (end) {
+                    ++pos;
+                    if (!out.empty() and out.back() == '\r')
+                        out.pop_back();
+                    return true;
+                }
+            }
+        }
+
+        //next integer, throws at the end or on anything else
+        long long integer(void) {
+            int c;
+            while ((c = peek()) != -1 and std::isspace(c))
+                ++pos;
+            bool negative = c == '-';
+            if (negative)
+                ++pos;
+            if ((c = peek()) == -1 or !std::isdigit(c))
+                throw std::runtime_error("expected an integer");
+
+            long long x = 0;
+            while ((c = peek()) != -1 and std::isdigit(c)) {
+                if (x > (1LL << 40))
+                    throw std::runtime_error("integer out of range");
+                x = x * 10 + (c - '0');
+                ++pos;
+            }
+            return negative ? -x : x;
+        }
+
+        int peek(void) {
+            if (pos == len and !fill())
+                return -1;
+            return (unsigned char)buf[pos];
+        }
+};
+
+//===========================================
+// sendAll
+// this method writes all of text to the socket.
+// params: the socket, the text
+// return value: false if the peer is gone.
+//===========================================
+bool sendAll(const int fd, const std::string &text) {
+    size_t done = 0;
+
+    while (done < text.size()) {
+        ssize_t n = ::send(fd, text.data() + done, text.size() - done, MSG_NOSIGNAL);
+        if (n < 0 and errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        done += n;
+    }
+    return true;
+}
+
+//===========================================
+// toInt
+// this method narrows a value read from a request to an int.
+// params: the value, what it is (for the error)
+// return value: the int.
+//===========================================
+int toInt(const long long x, const char *what) {
+    if (x < -2147483647LL - 1 or x > 2147483647LL)
+        throw std::runtime_error(std::string(what) + " out of range");
+    return (int)x;
+}
+
+uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+//Queue of the answers of one connection, in request order
+struct AnswerQueue {
+    std::mutex lock;
+    std::condition_variable ready;
+    std::deque<std::function<std::string(void)>> answers;
+    bool closed = false;
+};
+
+}
+
+//===========================================
+// WorkerPool constructor
+// params: thread count (at least 1)
+// return value: none
+//===========================================
+WorkerPool::WorkerPool(const int threads) : stopping(false) {
+    for (int t = 0; t < std::max(1, threads); ++t)
+        workers.emplace_back(&WorkerPool::work, this);
+}
+
+WorkerPool::~WorkerPool(void) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    ready.notify_all();
+    for (auto& w : workers)
+        w.join();
+}
+//===========================================
+// submit
+// this method queues a job for the next free worker.
+// params: the job
+// return value: none.
+//===========================================
+void WorkerPool::submit(std::function<void(void)> job) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        jobs.push_back(std::move(job));
+    }
+    ready.notify_one();
+}
+//===========================================
+// work
+// this method runs jobs until the pool stops and the queue is empty.
+// params: none
+// return value: none.
+//===========================================
+void WorkerPool::work(void) {
+    while (true) {
+        std::function<void(void)> job;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            ready.wait(guard, [this]() { return stopping or !jobs.empty(); });
+            if (jobs.empty())
+                return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
+//===========================================
+// hashJob
+// this method hashes a job twice (FNV-1a and a splitmix chain), after
+// putting every undirected edge as (min, max) and sorting the list.
+// params: vertex count, the edges (normalized and sorted), algorithm
+// return value: the key.
+//===========================================
+JobKey hashJob(const int V, std::vector<std::tuple<int, int, int>> &edge_list, const MSTAlgorithm a) {
+    #ifndef DIRECTED_GRAPH
+    for (auto& e : edge_list) {
+        if (std::get<0>(e) > std::get<1>(e))
+            std::swap(std::get<0>(e), std::get<1>(e));
+    }
+    #endif
+    std::sort(edge_list.begin(), edge_list.end());
+
+    JobKey key = { 0xcbf29ce484222325ULL, 0 };
+    auto add = [&key](const int x) {
+        uint32_t u = (uint32_t)x;
+        for (int i = 0; i < 4; ++i) {
+            key.a ^= (u >> (8 * i)) & 0xff;
+            key.a *= 0x100000001b3ULL;
+        }
+        key.b = mix(key.b ^ u);
+    };
+
+    add(V);
+    add((int)a);
+    add((int)edge_list.size());
+    for (const auto& e : edge_list) {
+        add(std::get<0>(e));
+        add(std::get<1>(e));
+        add(std::get<2>(e));
+    }
+    return key;
+}
+//===========================================
+// runMSTJob
+// this method builds the backend the factory picks for the graph and
+// runs the MST algorithm (the factory's choice for AUTO).
+// params: vertex count, the edges, algorithm
+// return value: the result.
+//===========================================
+std::shared_ptr<const MSTResult> runMSTJob(const int V, const std::vector<std::tuple<int, int, int>> &edge_list,
+                                           const MSTAlgorithm a) {
+    GraphOptions opts;
+    opts.algorithm = a;
+    opts.log = nullptr;
+
+    GraphChoice choice = chooseGraph(V, (int)edge_list.size(), opts);
+    Graph *gp = makeGraph(V, (int)edge_list.size(), choice);
+    Graph *mstp = nullptr;
+
+    try {
+        loadEdges(*gp, edge_list);
+        //one thread per job: the pool already runs a job per worker
+        mstp = computeMST(*gp, choice.algorithm, 1);
+    }
+    catch (...) {
+        delete gp;
+        throw;
+    }
+
+    std::shared_ptr<MSTResult> result = std::make_shared<MSTResult>();
+    result->vert_count = V;
+    result->mass = mstp->mass();
+    result->algorithm = choice.algorithm;
+    result->edges.assign(mstp->getEdges().begin(), mstp->getEdges().end());
+
+    delete gp;
+    delete mstp;
+    return result;
+}
+//===========================================
+// MSTServer constructor
+// this method binds and listens on the socket, replacing a stale one;
+// any other file at the path is left alone and is an error.
+// params: socket path, worker count, cache entries
+// return value: none
+//===========================================
+MSTServer::MSTServer(const std::string &socket_path, const int workers, const size_t entries) : \
+    path(socket_path), listen_fd(-1), pool(workers), cache_entries(std::max((size_t)1, entries)), stopping(false) {
+    sockaddr_un addr;
+
+    if (path.empty() or path.size() >= sizeof(addr.sun_path))
+        throw std::invalid_argument("MSTServer - Invalid Socket Path");
+
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size());
+
+    listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0)
+        throw std::runtime_error(std::string("MSTServer - socket: ") + std::strerror(errno));
+
+    //a socket left by an earlier server is replaced, anything else is kept
+    struct stat st;
+    if (::lstat(path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            ::close(listen_fd);
+            throw std::runtime_error("MSTServer - Path Exists");
+        }
+        ::unlink(path.c_str());
+    }
+    if (::bind(listen_fd, (sockaddr*)&addr, sizeof(addr)) < 0 or ::listen(listen_fd, 64) < 0
+        or ::lstat(path.c_str(), &st) < 0) {
+        int err = errno;
+        ::close(listen_fd);
+        throw std::runtime_error(std::string("MSTServer - bind: ") + std::strerror(err));
+    }
+    socket_dev = st.st_dev;
+    socket_ino = st.st_ino;
+}
+
+MSTServer::~MSTServer(void) {
+    stop();
+    std::unique_lock<std::mutex> guard(conn_lock);
+    idle.wait(guard, [this]() { return open_fds.empty(); });
+    guard.unlock();
+
+    //unless another server has replaced the socket since
+    struct stat st;
+    ::close(listen_fd);
+    if (::lstat(path.c_str(), &st) == 0 and st.st_dev == socket_dev and st.st_ino == socket_ino)
+        ::unlink(path.c_str());
+}
+//===========================================
+// run
+// this method accepts connections, one reader thread each, until the
+// server stops, then waits for the open connections to finish.
+// params: none
+// return value: none.
+//===========================================
+void MSTServer::run(void) {
+    while (!stopping) {
+        int fd = ::accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR or errno == ECONNABORTED)
+                continue;
+            break;
+        }
+
+        std::lock_guard<std::mutex> guard(conn_lock);
+        if (stopping) {
+            ::close(fd);
+            break;
+        }
+        open_fds.insert(fd);
+        std::thread(&MSTServer::serve, this, fd).detach();
+    }
+
+    std::unique_lock<std::mutex> guard(conn_lock);
+    idle.wait(guard, [this]() { return open_fds.empty(); });
+}
+//===========================================
+// stop
+// this method stops accepting and ends the reading of every open
+// connection; the answers already queued are still sent.
+// params: none
+// return value: none.
+//===========================================
+void MSTServer::stop(void) {
+    std::lock_guard<std::mutex> guard(conn_lock);
+
+    if (stopping.exchange(true))
+        return;
+    ::shutdown(listen_fd, SHUT_RDWR);
+    for (int fd : open_fds)
+        ::shutdown(fd, SHUT_RD);
+}
+
+ServerStats MSTServer::stats(void) {
+    std::lock_guard<std::mutex> guard(stats_lock);
+    return counters;
+}
+
+void MSTServer::count(long ServerStats::*field) {
+    std::lock_guard<std::mutex> guard(stats_lock);
+    counters.*field += 1;
+}
+//===========================================
+// submit
+// this method finds the job in the cache or queues it on the pool. A
+// cached job that failed is queued again.
+// params: vertex count, the edges (sorted by hashJob), algorithm,
+//         whether the cache had it (output)
+// return value: the pending result.
+//===========================================
+MSTServer::Pending MSTServer::submit(const int V, std::vector<std::tuple<int, int, int>> &edge_list,
+                                     const MSTAlgorithm a, bool &hit) {
+    JobKey key = hashJob(V, edge_list, a);
+    std::lock_guard<std::mutex> guard(cache_lock);
+
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        Pending &p = it->second.first;
+        bool failed = false;
+
+        if (p.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            try {
+                p.get();
+            }
+            catch (...) {
+                failed = true;
+            }
+        }
+        if (!failed) {
+            use_order.splice(use_order.begin(), use_order, it->second.second);
+            hit = true;
+            return p;
+        }
+        use_order.erase(it->second.second);
+        cache.erase(it);
+    }
+
+    auto promise = std::make_shared<std::promise<std::shared_ptr<const MSTResult>>>();
+    auto edges = std::make_shared<std::vector<std::tuple<int, int, int>>>(std::move(edge_list));
+    Pending p = promise->get_future().share();
+
+    pool.submit([promise, edges, V, a]() {
+        try {
+            promise->set_value(runMSTJob(V, *edges, a));
+        }
+        catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+
+    use_order.push_front(key);
+    cache[key] = std::make_pair(p, use_order.begin());
+    while (cache.size() > cache_entries) {
+        cache.erase(use_order.back());
+        use_order.pop_back();
+    }
+    hit = false;
+    return p;
+}
+//===========================================
+// serve
+// this method reads the requests of one connection and queues their
+// answers for its writer thread.
+// params: the connection socket
+// return value: none.
+//===========================================
+void MSTServer::serve(const int fd) {
+    SocketReader in(fd);
+    AnswerQueue out;
+
+    std::thread writer([fd, &out]() {
+        bool peer = true;
+        while (true) {
+            std::function<std::string(void)> answer;
+            {
+                std::unique_lock<std::mutex> guard(out.lock);
+                out.ready.wait(guard, [&out]() { return out.closed or !out.answers.empty(); });
+                if (out.answers.empty())
+                    return;
+                answer = std::move(out.answers.front());
+                out.answers.pop_front();
+            }
+            std::string text = answer();    //waits for the job
+            if (peer)
+                peer = sendAll(fd, text);
+        }
+    });
+
+    auto queue = [&out](std::function<std::string(void)> answer) {
+        {
+            std::lock_guard<std::mutex> guard(out.lock);
+            out.answers.push_back(std::move(answer));
+        }
+        out.ready.notify_one();
+    };
+    auto error = [this, &queue](const std::string &why) {
+        count(&ServerStats::errors);
+        queue([why]() { return "ERR " + why + "\n"; });
+    };
+
+    std::string request;
+    bool shutdown = false;
+    while (!shutdown and in.line(request)) {
+        std::istringstream words(request);
+        std::string verb, alg, source;
+        words >> verb;
+
+        if (verb.empty())
+            continue;
+        count(&ServerStats::requests);
+
+        if (verb == "QUIT")
+            break;
+        if (verb == "SHUTDOWN") {
+            shutdown = true;
+            queue([]() { return std::string("OK shutdown\n"); });
+            break;
+        }
+        if (verb == "STATS") {
+            ServerStats s = stats();
+            size_t entries;
+            {
+                std::lock_guard<std::mutex> guard(cache_lock);
+                entries = cache.size();
+            }
+            std::ostringstream os;
+            os << "STATS requests " << s.requests << " computed " << s.computed << " cached " << s.cached
+               << " errors " << s.errors << " entries " << entries << " workers " << pool.size() << "\n";
+            std::string text = os.str();
+            queue([text]() { return text; });
+            continue;
+        }
+        if (verb != "MST") {
+            error("unknown request " + verb);
+            continue;
+        }
+
+        words >> alg >> source;
+        MSTAlgorithm a;
+        if (alg == "prim")          a = MSTAlgorithm::PRIM;
+        else if (alg == "kruskal")  a = MSTAlgorithm::KRUSKAL;
+        else if (alg == "auto")     a = MSTAlgorithm::AUTO;
+        else {
+            error("unknown algorithm " + alg);
+            continue;
+        }
+
+        int V = 0;
+        std::vector<std::tuple<int, int, int>> edge_list;
+        if (source == "GRAPH") {
+            //a graph that cannot be parsed leaves the stream out of step: give up on it
+            try {
+                V = toInt(in.integer(), "vertex count");
+                int E = toInt(in.integer(), "edge count");
+                if (V < 0 or E < 0)
+                    throw std::runtime_error("invalid header");
+                edge_list.reserve(std::min(E, 1 << 20));
+                for (int i = 0; i < E; ++i) {
+                    int v1 = toInt(in.integer(), "vertex");
+                    int v2 = toInt(in.integer(), "vertex");
+                    int w = toInt(in.integer(), "weight");
+                    edge_list.emplace_back(v1, v2, w);
+                }
+            }
+            catch (const std::exception &ex) {
+                error(std::string("bad graph: ") + ex.what());
+                break;
+            }
+        }
+        else if (source == "FILE") {
+            std::string file;
+            std::getline(words >> std::ws, file);
+            std::ifstream is(file, std::ios::binary);
+            if (!is) {
+                error("cannot open " + file);
+                continue;
+            }
+            try {
+                readBinary(is, V, edge_list);
+            }
+            catch (const std::exception &ex) {
+                error(ex.what());
+                continue;
+            }
+        }
+        else {
+            error("unknown source " + source);
+            continue;
+        }
+
+        bool hit;
+        Pending p = submit(V, edge_list, a, hit);
+        count(hit ? &ServerStats::cached : &ServerStats::computed);
+
+        queue([this, p, hit]() {
+            std::shared_ptr<const MSTResult> r;
+            try {
+                r = p.get();
+            }
+            catch (const std::exception &ex) {
+                count(&ServerStats::errors);
+                return "ERR " + std::string(ex.what()) + "\n";
+            }
+
+            std::ostringstream os;
+            {
+                OutputWriter w(os);
+                w << "OK " << (r->algorithm == MSTAlgorithm::PRIM ? "prim" : "kruskal") << ' '
+                  << r->vert_count << ' ' << r->edges.size() << ' ' << r->mass << ' '
+                  << (hit ? "cached" : "computed") << '\n';
+                for (const auto& e : r->edges)
+                    w << std::get<0>(e) << ' ' << std::get<1>(e) << ' ' << std::get<2>(e) << '\n';
+            }
+            return os.str();
+        });
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(out.lock);
+        out.closed = true;
+    }
+    out.ready.notify_one();
+    writer.join();
+
+    if (shutdown)
+        stop();
+
+    std::lock_guard<std::mutex> guard(conn_lock);
+    ::close(fd);
+    open_fds.erase(fd);
+    idle.notify_all();
+}
@@ -0,0 +1,145 @@
+//================================================================
+// Server.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the MST job server. It listens on a
+// Unix domain socket and answers one request per line:
+//     MST <prim|kruskal|auto> GRAPH    followed by the graph in the
+//                                      input format ("nv ne", edges)
+//     MST <prim|kruskal|auto> FILE <path>   a graph in the binary
+//                                      format of GraphIO.h
+//     STATS                            counters of the server
+//     QUIT                             closes the connection
+//     SHUTDOWN                         stops the server ("OK shutdown")
+// An MST is answered with
+//     OK <algorithm> <vertices> <edges> <mass> <computed|cached>
+// and its edges, one "v1 v2 w" line each; any error with "ERR <why>".
+// The jobs run on a pool of worker threads. A connection may send
+// several requests without waiting: they are read and queued at once,
+// and answered in order as they complete. Results are cached by a hash
+// of the vertex count, the algorithm and the sorted edge set, so the
+// same graph in any edge order is computed once; a request for a graph
+// still being computed waits for that job instead of starting another.
+//================================================================
+
+#include "Graph.h"
+#include "GraphFactory.h"
+#include <string>
+#include <vector>
+#include <tuple>
+#include <deque>
+#include <list>
+#include <map>
+#include <set>
+#include <memory>
+#include <future>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <sys/types.h>
+
+#ifndef SERVER_H
+#define SERVER_H
+
+//Results kept by the cache, least recently used dropped first
+const size_t SERVER_CACHE_ENTRIES = 256;
+
+//Fixed set of threads running queued jobs in order of submission
+class WorkerPool {
+    private:
+        std::vector<std::thread> workers;
+        std::deque<std::function<void(void)>> jobs;
+        std::mutex lock;
+        std::condition_variable ready;
+        bool stopping;
+
+        void work(void);
+
+    public:
+        WorkerPool(const int threads);
+        ~WorkerPool(void);      //runs the jobs left, then joins
+
+        WorkerPool(const WorkerPool &other) = delete;
+        WorkerPool& operator=(const WorkerPool &other) = delete;
+
+        void submit(std::function<void(void)> job);
+        int  size(void) const { return (int)workers.size(); }
+};
+
+//A finished MST, shared by the cache and the answers
+struct MSTResult {
+    int vert_count;
+    long long mass;
+    MSTAlgorithm algorithm;
+    std::vector<std::tuple<int, int, int>> edges;
+};
+
+//Two independent 64-bit hashes of a job
+struct JobKey {
+    uint64_t a;
+    uint64_t b;
+
+    bool operator<(const JobKey &o) const { return a != o.a ? a < o.a : b < o.b; }
+};
+
+struct ServerStats {
+    long requests = 0;
+    long computed = 0;
+    long cached = 0;
+    long errors = 0;
+};
+
+class MSTServer {
+    private:
+        typedef std::shared_future<std::shared_ptr<const MSTResult>> Pending;
+
+        std::string path;
+        int listen_fd;
+        dev_t socket_dev;       //the socket bound at path, removed on exit
+        ino_t socket_ino;       //only if it is still there
+        WorkerPool pool;
+        size_t cache_entries;
+
+        //cache: key -> (result, position in the use order)
+        std::mutex cache_lock;
+        std::map<JobKey, std::pair<Pending, std::list<JobKey>::iterator>> cache;
+        std::list<JobKey> use_order;        //most recent first
+
+        std::mutex conn_lock;
+        std::condition_variable idle;
+        std::set<int> open_fds;         //connections being served
+        std::atomic<bool> stopping;
+
+        std::mutex stats_lock;
+        ServerStats counters;
+
+        void    serve   (const int fd);
+        Pending submit  (const int V, std::vector<std::tuple<int, int, int>> &edge_list,
+                         const MSTAlgorithm a, bool &hit);
+        void    count   (long ServerStats::*field);
+
+    public:
+        //Replaces a socket left at socket_path, throws on any other file
+        MSTServer(const std::string &socket_path, const int workers, const size_t entries = SERVER_CACHE_ENTRIES);
+        ~MSTServer(void);
+
+        MSTServer(const MSTServer &other) = delete;
+        MSTServer& operator=(const MSTServer &other) = delete;
+
+        //Accepts connections until SHUTDOWN or stop()
+        void run(void);
+        void stop(void);
+        ServerStats stats(void);
+};
+
+//Hash of the vertex count, the algorithm and the edge set; the edges are
+//normalized and sorted in place first, so their order does not matter
+JobKey  hashJob (const int V, std::vector<std::tuple<int, int, int>> &edge_list, const MSTAlgorithm a);
+//Builds the graph the factory would pick and runs the MST
+std::shared_ptr<const MSTResult> runMSTJob(const int V, const std::vector<std::tuple<int, int, int>> &edge_list,
+                                           const MSTAlgorithm a);
+
+#endif
@@ -0,0 +1,281 @@
+//================================================================
+// ShortestPaths.cpp
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This is the ShortestPaths.cpp file that implements Dijkstra and
+// delta-stepping. A round of delta-stepping has two phases:
+//     relax  every thread scans the arcs of its share of the bucket
+//            and writes requests (v, new distance, pred) into one
+//            list per owner of v; nothing shared is written
+//     apply  every thread applies the requests for the vertices it
+//            owns and files them into its own buckets
+// so no vertex is ever written by two threads and no lock is needed.
+// Requests are applied only if they improve the distance, so pred
+// never forms a cycle, even with zero weights.
+//================================================================
+
+#include "ShortestPaths.h"
+#include "Parallel.h"
+#include <stdexcept>
+#include <limits>
+#include <map>
+#include <algorithm>
+
+namespace {
+
+const long long UNREACHED = std::numeric_limits<long long>::max();
+
+//Binary min-heap of vertices keyed by dist, with the position of every
+//vertex so that a key can be decreased in place
+class IndexedHeap {
+    private:
+        const std::vector<long long> &key;
+        std::vector<int> heap;
+        std::vector<int> pos;       //-1: not in the heap
+
+        void place(const int i, const int v) { heap[i] = v; pos[v] = i; }
+
+        void up(int i) {
+            int v = heap[i];
+            while (i > 0 and key[heap[(i - 1) / 2]] > key[v]) {
+                place(i, heap[(i - 1) / 2]);
+                i = (i - 1) / 2;
+            }
+            place(i, v);
+        }
+
+        void down(int i) {
+            int v = heap[i];
+            int n = (int)heap.size();
+            while (2 * i + 1 < n) {
+                int c = 2 * i + 1;
+                if (c + 1 < n and key[heap[c + 1]] < key[heap[c]])
+                    ++c;
+                if (key[heap[c]] >= key[v])
+                    break;
+                place(i, heap[c]);
+                i = c;
+            }
+            place(i, v);
+        }
+    public:
+        IndexedHeap(const std::vector<long long> &k) : key(k), pos(k.size(), -1) {}
+
+        bool empty(void) const { return heap.empty(); }
+
+        //inserts v, or moves it up after its key decreased
+        void push(const int v) {
+            if (pos[v] == -1) {
+                heap.push_back(v);
+                pos[v] = (int)heap.size() - 1;
+            }
+            up(pos[v]);
+        }
+
+        int pop(void) {
+            int top = heap[0];
+            pos[top] = -1;
+            int last = heap.back();
+            heap.pop_back();
+            if (!heap.empty()) {
+                place(0, last);
+                down(0);
+            }
+            return top;
+        }
+};
+
+//===========================================
+// finish
+// this method turns the unreached distances into -1.
+// params: the state
+// return value: none.
+//===========================================
+void finish(PathState &state) {
+    for (auto& d : state.dist) {
+        if (d == UNREACHED)
+            d = -1;
+    }
+}
+
+//One relaxation to apply: (vertex, new distance, predecessor)
+struct Request {
+    int v;
+    long long dist;
+    int pred;
+};
+
+}
+
+//===========================================
+// dijkstra
+// this method finds the shortest paths from source.
+// params: the view, the source, the state to fill.
+// return value: none.
+//===========================================
+void dijkstra(const GraphView &view, const int source, PathState &state) {
+    const int V = view.size();
+
+    if (source < 0 or source > V - 1)
+        throw std::invalid_argument("dijkstra - source out of range");
+
+    state.dist.assign(V, UNREACHED);
+    state.pred.assign(V, -1);
+
+    IndexedHeap Q(state.dist);
+    state.dist[source] = 0;
+    Q.push(source);
+
+    while (!Q.empty()) {
+        int u = Q.pop();
+        long long du = state.dist[u];
+        const int *t = view.targets(u);
+        const int *w = view.weights(u);
+
+        for (int a = 0, d = view.degree(u); a < d; ++a) {
+            if (du + w[a] < state.dist[t[a]]) {
+                state.dist[t[a]] = du + w[a];
+                state.pred[t[a]] = u;
+                Q.push(t[a]);
+            }
+        }
+    }
+    finish(state);
+}
+//===========================================
+// deltaStepping
+// this method finds the shortest paths from source with buckets of
+// width delta. The smallest bucket is relaxed along its light arcs
+// (weight <= delta) until it stays empty, then every vertex it held is
+// relaxed once along its heavy arcs.
+// params: the view, the source, the state to fill, thread count,
+//         bucket width (0: max weight / average degree, at least 1)
+// return value: none.
+//===========================================
+void deltaStepping(const GraphView &view, const int source, PathState &state, const int threads, long long delta) {
+    const int V = view.size();
+    const int T = std::max(1, threads);
+
+    if (source < 0 or source > V - 1)
+        throw std::invalid_argument("deltaStepping - source out of range");
+    if (delta < 0)
+        throw std::invalid_argument("deltaStepping - Invalid Delta");
+    if (delta == 0) {
+        double degree = (double)view.numArcs() / V;
+        delta = std::max(1LL, (long long)(view.maxWeight() / std::max(1.0, degree)));
+    }
+
+    state.dist.assign(V, UNREACHED);
+    state.pred.assign(V, -1);
+
+    auto owner = [V, T](const int v) { return (int)((long long)v * T / V); };
+
+    //buckets[o]: bucket index -> vertices of owner o (possibly stale)
+    std::vector<std::map<long long, std::vector<int>>> buckets(T);
+    std::vector<std::vector<std::vector<Request>>> requests(T, std::vector<std::vector<Request>>(T));
+    std::vector<long long> stamp(V, -1);     //last round a vertex was taken in
+    long long round = 0;
+
+    auto relax = [&](const std::vector<int> &from, const bool light) {
+        parallelFor(T, from.size(), [&](int t, size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                int u = from[i];
+                long long du = state.dist[u];
+                const int *to = view.targets(u);
+                const int *w = view.weights(u);
+
+                for (int a = 0, d = view.degree(u); a < d; ++a) {
+                    if ((w[a] <= delta) == light and du + w[a] < state.dist[to[a]])
+                        requests[t][owner(to[a])].push_back({to[a], du + w[a], u});
+                }
+            }
+        });
+        parallelFor(T, T, [&](int, size_t lo, size_t hi) {
+            for (size_t o = lo; o < hi; ++o) {
+                for (int t = 0; t < T; ++t) {
+                    for (const auto& r : requests[t][o]) {
+                        if (r.dist < state.dist[r.v]) {
+                            state.dist[r.v] = r.dist;
+                            state.pred[r.v] = r.pred;
+                            buckets[o][r.dist / delta].push_back(r.v);
+                        }
+                    }
+                    requests[t][o].clear();
+                }
+            }
+        });
+    };
+
+    state.dist[source] = 0;
+    buckets[owner(source)][0].push_back(source);
+
+    std::vector<int> frontier, settled;
+    while (true) {
+        long long b = -1;
+        for (int o = 0; o < T; ++o) {
+            if (!buckets[o].empty() and (b == -1 or buckets[o].begin()->first < b))
+                b = buckets[o].begin()->first;
+        }
+        if (b == -1)
+            break;
+
+        settled.clear();
+        while (true) {
+            frontier.clear();
+            ++round;
+            for (int o = 0; o < T; ++o) {
+                auto it = buckets[o].find(b);
+                if (it == buckets[o].end())
+                    continue;
+                for (int v : it->second) {
+                    //skip stale copies (the vertex has moved down) and duplicates
+                    if (state.dist[v] / delta == b and stamp[v] != round) {
+                        stamp[v] = round;
+                        frontier.push_back(v);
+                    }
+                }
+                buckets[o].erase(it);
+            }
+            if (frontier.empty())
+                break;
+
+            settled.insert(settled.end(), frontier.begin(), frontier.end());
+            relax(frontier, true);
+        }
+        std::sort(settled.begin(), settled.end());
+        settled.erase(std::unique(settled.begin(), settled.end()), settled.end());
+        relax(settled, false);
+    }
+    finish(state);
+}
+//===========================================
+// shortestPaths
+// this method runs the shortest paths on any backend.
+// params: Graph &g, the source, the state to fill, thread count
+// return value: none.
+//===========================================
+void shortestPaths(const Graph &g, const int source, PathState &state, const int threads) {
+    GraphView view(g);
+
+    if (threads > 1)
+        deltaStepping(view, source, state, threads);
+    else
+        dijkstra(view, source, state);
+}
+//===========================================
+// printShortestPath
+// this method prints the path from s to d found by a search from s.
+// params: int s, int d, the state of the search, the output stream.
+// return value: nothing.
+//===========================================
+void printShortestPath(const int s, const int d, const PathState &state, std::ostream &os) {
+    std::vector<int> path = tracePath(state.pred, s, d);
+
+    if (path.empty()) {
+        os << "No such path\n";
+        return;
+    }
+    for (const auto& vert : path)
+        os << "v" << vert << " ";
+    os << "dist=" << state.dist[d] << "\n";
+}
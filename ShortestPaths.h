@@ -0,0 +1,39 @@
+//================================================================
+// ShortestPaths.h
+// Tomer Osmo, Daniel Chu and Caroline Cavalier
+// April 2024
+// This file is the header file for the weighted single-source
+// shortest paths. They run on a GraphView, so on either backend, and
+// leave their result in a state owned by the caller, as the BFS of
+// GraphView does. Distances are long long: a path of many edges can
+// outgrow the int weights.
+//     dijkstra       sequential, with an indexed binary heap
+//     deltaStepping  buckets of width delta; the vertices of a bucket
+//                    are relaxed together, spread over the threads
+//================================================================
+
+#include "Graph.h"
+#include "GraphView.h"
+#include <vector>
+#include <iostream>
+
+#ifndef SHORTESTPATHS_H
+#define SHORTESTPATHS_H
+
+//Results of a shortest path search, indexed by vertex
+struct PathState {
+    std::vector<long long> dist;    //-1 for unreachable vertices
+    std::vector<int> pred;          //-1: NIL
+};
+
+void    dijkstra        (const GraphView &view, const int source, PathState &state);
+//delta 0 picks one from the weights and the average degree
+void    deltaStepping   (const GraphView &view, const int source, PathState &state,
+                         const int threads = 1, long long delta = 0);
+//Dijkstra, or delta-stepping when threads > 1, on any backend
+void    shortestPaths   (const Graph &g, const int source, PathState &state, const int threads = 1);
+
+//Prints "v<s> ... v<d> dist=<length>", or "No such path"
+void    printShortestPath(const int s, const int d, const PathState &state, std::ostream &os);
+
+#endif
@@ -14,8 +14,12 @@
 
 
 #include "SparseGraph.h"
+#include "Parallel.h"
+#include "MSTCore.h"
 #include <stdexcept>
 #include <limits>
+#include <algorithm>
+#include <cstdint>
 
 
 
@@ -36,13 +40,75 @@ SparseGraph::SparseGraph(void) : \
 SparseGraph::SparseGraph(const int V, const int E) : \
     Graph(V, E), adj_list(V) {}
 //===========================================
+// Parallel constructors
+// these methods build the graph from an edge list (or from the rest of
+// a stream, read as operator>> would) with several threads. The result
+// is the same as E calls to insertEdge: same lists in the same order,
+// same edge set, same exceptions for invalid edges.
+// params: vertices, edges, the edge list or istream &is, thread count
+// return value: none
+//===========================================
+SparseGraph::SparseGraph(const int V, const int E, const std::vector<std::tuple<int,int,int>> &edge_list, const int threads) : \
+    Graph(V, E), adj_list(V) {
+    build(buildAdjacency(V, edge_list, threads), threads);
+}
+
+SparseGraph::SparseGraph(const int V, const int E, std::istream &is, const int threads) : \
+    Graph(V, E), adj_list(V) {
+    build(buildAdjacency(V, readEdgesParallel(is, E, threads), threads), threads);
+}
+//===========================================
+// build
+// this method fills the lists and the edge set from the adjacency,
+// in parallel by blocks of vertices. Each block sorts its rows into a
+// set of its own, so every insertion is at the end; the blocks hold
+// increasing rows, so their nodes are then moved into the edge set
+// one after the other, again at the end, without allocating.
+// params: the adjacency, thread count
+// return value: none
+//===========================================
+void SparseGraph::build(const Adjacency &adj, const int threads) {
+    const int T = std::max(1, threads);
+    std::vector<std::set<std::tuple<int,int,int>>> block(T);
+    std::vector<int> block_max(T, -1);
+
+    parallelFor(T, vert_count, [&](int t, size_t lo, size_t hi) {
+        std::vector<std::tuple<int,int,int>> row;
+
+        for (size_t v = lo; v < hi; ++v) {
+            adj_list[v].assign(adj.arcs.begin() + adj.offset[v], adj.arcs.begin() + adj.offset[v + 1]);
+
+            row.clear();
+            for (size_t a = adj.offset[v]; a < adj.offset[v + 1]; ++a) {
+                row.emplace_back((int)v, adj.arcs[a].first, adj.arcs[a].second);
+                block_max[t] = std::max(block_max[t], adj.arcs[a].second);
+            }
+            std::sort(row.begin(), row.end());
+            for (const auto& arc : row)
+                block[t].insert(block[t].end(), arc);
+        }
+    });
+
+    for (auto& b : block) {
+        if (edges.empty())
+            edges.swap(b);
+        while (!b.empty())
+            edges.insert(edges.end(), b.extract(b.begin()));
+    }
+    for (int m : block_max)
+        max_weight = std::max(max_weight, m);
+}
+//===========================================
 // copy constructor
 // this method creates a copy of the SparseGraph object. 
 // params: const Graph &gp
 // return value: none
 //===========================================
 SparseGraph::SparseGraph(const SparseGraph &other) : \
-    Graph(other.vert_count, other.edge_count), adj_list(other.adj_list) {}
+    Graph(other.vert_count, other.edge_count), adj_list(other.adj_list), \
+    index(other.index ? new EdgeIndex(*other.index) : nullptr) {
+    max_weight = other.max_weight;
+}
 //===========================================
 // assignment operator
 // this method creates a new SparseGraph object with same vertices 
@@ -54,7 +120,9 @@ SparseGraph& SparseGraph::operator=(const SparseGraph &other) {
     if (this != &other) {
         vert_count = other.vert_count;
         edge_count = other.edge_count;
+        max_weight = other.max_weight;
         adj_list = other.adj_list;
+        index.reset(other.index ? new EdgeIndex(*other.index) : nullptr);
     }
     return *this;
 }
@@ -69,33 +137,131 @@ bool SparseGraph::isEdge(const int v1, const int v2) const {
     if (v1 >= vert_count or v2 >= vert_count or v1 < 0 or v2 < 0)
         throw std::invalid_argument("isEdge - Invalid Vertices");
 
-    for (const auto& edge : adj_list[v1]) {
-        if (edge.first == v2)
-            return true;
-    }
-    return false;
+    return getWeight(v1, v2) >= 0;
 }
 //===========================================
 // getWeight
 // this method returns the weight from the edge from v1 to v2. 
-// The method will throw an exception if there is no edge or if the vertices
-// are invalid. 
+// The method will throw an exception if the vertices are invalid and
+// returns -1 if there is no edge. Uses the edge index when there is one,
+// otherwise walks the adjacency list of v1 once.
 // params: two vertices - v1, v2. 
 // return value: the weight for the edge from v1 to v2. 
 //===========================================
 int SparseGraph::getWeight(const int v1, const int v2) const {
     if (v1 >= vert_count or v2 >= vert_count or v1 < 0 or v2 < 0)
         throw std::invalid_argument("getWeight - Invalid Vertices");
-    if (!isEdge(v1,v2)) return -1;
 
-    int w = -1;
+    if (index)
+        return index->find(v1, v2);
+
     for (const auto& edge : adj_list[v1]) {
-        if (edge.first == v2) {
-            w = edge.second;
-            break;
-        }
+        if (edge.first == v2)
+            return edge.second;
+    }
+    return -1;
+}
+//===========================================
+// getWeights
+// this method looks up a batch of pairs. With the edge index the slot
+// of each pair is prefetched a few lookups ahead, so the cache misses
+// of the batch overlap instead of being paid one after the other.
+// params: the (v1, v2) pairs, the vector receiving the weights.
+// return value: none.
+//===========================================
+void SparseGraph::getWeights(const std::vector<std::pair<int,int>> &pairs, std::vector<int> &out) const {
+    const size_t AHEAD = 8;
+
+    for (const auto& p : pairs) {
+        if (p.first >= vert_count or p.second >= vert_count or p.first < 0 or p.second < 0)
+            throw std::invalid_argument("getWeights - Invalid Vertices");
+    }
+    if (!index) {
+        Graph::getWeights(pairs, out);
+        return;
+    }
+
+    out.resize(pairs.size());
+    for (size_t i = 0; i < pairs.size() and i < AHEAD; ++i)
+        index->prefetch(pairs[i].first, pairs[i].second);
+
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        if (i + AHEAD < pairs.size())
+            index->prefetch(pairs[i + AHEAD].first, pairs[i + AHEAD].second);
+        out[i] = index->find(pairs[i].first, pairs[i].second);
     }
-    return w;
+}
+//===========================================
+// buildEdgeIndex
+// this method builds the edge index from the adjacency lists. For
+// parallel edges the first one in the list wins, as in the list walk.
+// params: none.
+// return value: none.
+//===========================================
+void SparseGraph::buildEdgeIndex(void) {
+    size_t arcs = 0;
+    for (const auto& adj : adj_list)
+        arcs += adj.size();
+
+    index.reset(new EdgeIndex(arcs));
+    for (int v = 0; v < vert_count; ++v) {
+        for (const auto& edge : adj_list[v])
+            index->insert(v, edge.first, edge.second);
+    }
+}
+//===========================================
+// neighbors
+// this method returns the adjacency list of v, in insertion order.
+// params: vertex v.
+// return value: list of (neighbor, weight) pairs.
+//===========================================
+const std::list<std::pair<int,int>>& SparseGraph::neighbors(const int v) const {
+    if (v >= vert_count or v < 0)
+        throw std::invalid_argument("neighbors - Invalid Vertex");
+
+    return adj_list[v];
+}
+//===========================================
+// getNeighbors
+// this method copies the adjacency list of v, in insertion order.
+// params: vertex v, the vector receiving the (neighbor, weight) pairs.
+// return value: none.
+//===========================================
+void SparseGraph::getNeighbors(const int v, std::vector<std::pair<int,int>> &out) const {
+    const auto& adj = neighbors(v);
+    out.assign(adj.begin(), adj.end());
+}
+//===========================================
+// relabel
+// this method returns a copy of the graph where vertex v is renamed
+// perm[v]. Every adjacency list keeps its order, so traversals of the
+// copy visit the same vertices in the same order as the original.
+// The lists are allocated in the order of the new labels.
+// params: the permutation, perm[old] = new.
+// return value: pointer to the new graph (owned by the caller).
+//===========================================
+SparseGraph* SparseGraph::relabel(const std::vector<int> &perm) const {
+    if ((int)perm.size() != vert_count)
+        throw std::invalid_argument("relabel - Invalid Permutation");
+
+    std::vector<int> inv(vert_count, -1);
+    for (int v = 0; v < vert_count; ++v) {
+        if (perm[v] < 0 or perm[v] >= vert_count or inv[perm[v]] != -1)
+            throw std::invalid_argument("relabel - Invalid Permutation");
+        inv[perm[v]] = v;
+    }
+
+    SparseGraph* g = new SparseGraph(vert_count, edge_count);
+    g->max_weight = max_weight;
+
+    for (int n = 0; n < vert_count; ++n) {
+        for (const auto& edge : adj_list[inv[n]])
+            g->adj_list[n].emplace_back(perm[edge.first], edge.second);
+    }
+    for (const auto& e : edges)
+        g->edges.insert(std::make_tuple(perm[std::get<0>(e)], perm[std::get<1>(e)], std::get<2>(e)));
+
+    return g;
 }
 //===========================================
 // insertEdge
@@ -112,10 +278,15 @@ void SparseGraph::insertEdge(const int v1, const int v2, int w) {
 
     adj_list[v1].emplace_back(v2, w);
     edges.insert(std::make_tuple(v1, v2, w));
+    max_weight = std::max(max_weight, w);
+    if (index)
+        index->insert(v1, v2, w);
 
     #ifndef DIRECTED_GRAPH
     adj_list[v2].emplace_back(v1, w);
     edges.insert(std::make_tuple(v2, v1, w));
+    if (index)
+        index->insert(v2, v1, w);
     #endif
 }
 //===========================================
@@ -200,44 +371,68 @@ void SparseGraph::DFS_Visit(int v, int &clock) {
     table["color"][v] = 2;
 }
 
+//===========================================
+// MST_Prim
+// Prim's algorithm grown from vertex 0 (or from root). When every
+// weight inserted is small the bucket queue version is used, the
+// binary heap one otherwise.
+// params: the root vertex.
+// return value: pointer to the MST (owned by the caller).
+//===========================================
 SparseGraph* SparseGraph::MST_Prim(void) {
-    SparseGraph* mst_graph = new SparseGraph(vert_count, 0);
-
-    std::priority_queue<std::tuple<int, int, int>, std::vector<std::tuple<int, int, int>>, sortbythird> pq;
-
-    std::set<int> inset;
-    std::set<int> outset;
-
-    inset.insert(0);
-    for (int i = 1; i < vert_count; ++i)
-        outset.insert(i);
-
-    for (const auto& edge : adj_list[0])
-        pq.push(std::make_tuple(0, edge.first, edge.second));
+    return MST_Prim(0);
+}
 
-    while (!outset.empty() && !pq.empty()) {
-        auto uvw = pq.top();
-        pq.pop();
+SparseGraph* SparseGraph::MST_Prim(const int root) {
+    if (max_weight < BUCKET_PRIM_MAX_WEIGHT)
+        return MST_PrimBucket(root);
+    return MST_PrimHeap(root);
+}
+//===========================================
+// MST_PrimHeap
+// Prim's algorithm with a binary heap of candidate edges.
+// params: the root vertex.
+// return value: pointer to the MST (owned by the caller).
+//===========================================
+SparseGraph* SparseGraph::MST_PrimHeap(const int root) {
+    SparseGraph* mst_graph = new SparseGraph(vert_count, 0);
 
-        int u = std::get<0>(uvw);
-        int v = std::get<1>(uvw);
-        int w = std::get<2>(uvw);
+    auto forEach = [this](int u, auto f) {
+        for (const auto& edge : adj_list[u])
+            f(edge.first, edge.second);
+    };
 
-        if ((inset.count(u) && outset.count(v)) || (inset.count(v) && outset.count(u))) {
-            mst_graph->edges.insert(uvw);
-            mst_graph->edge_count++;
+    try {
+        primHeap(vert_count, root, forEach, *mst_graph);
+    }
+    catch (...) {
+        delete mst_graph;
+        throw;
+    }
+    return mst_graph;
+}
+//===========================================
+// MST_PrimBucket
+// Prim's algorithm with a bucket queue indexed by weight, for graphs
+// whose weights are all small (see primBucket in MSTCore.h).
+// params: the root vertex.
+// return value: pointer to the MST (owned by the caller).
+//===========================================
+SparseGraph* SparseGraph::MST_PrimBucket(const int root) {
+    SparseGraph* mst_graph = new SparseGraph(vert_count, 0);
 
-            int new_vertex = outset.count(v) ? v : u;   
-            inset.insert(new_vertex);
-            outset.erase(new_vertex);
+    auto forEach = [this](int u, auto f) {
+        for (const auto& edge : adj_list[u])
+            f(edge.first, edge.second);
+    };
 
-            for (const auto& edge : adj_list[new_vertex]) {
-                if (outset.count(edge.first))
-                    pq.push(std::make_tuple(new_vertex, edge.first, edge.second));
-            }
-        }
+    try {
+        primBucket(vert_count, max_weight, root, forEach, *mst_graph);
+    }
+    catch (...) {
+        delete mst_graph;
+        throw;
     }
-
     return mst_graph;
 }
 
@@ -8,22 +8,35 @@
 //================================================================
 
 #include "Graph.h"
+#include "EdgeIndex.h"
+#include "ParallelBuild.h"
 #include <list>
+#include <memory>
 #include<tuple>
 #include <set>
 
 #ifndef SPARSEGRAPH_H
 #define SPARSEGRAPH_H
 
+//MST_Prim uses the bucket queue when every weight is below this
+const int BUCKET_PRIM_MAX_WEIGHT = 1 << 12;
+
 class SparseGraph : public Graph {
    
     private:
    //adjacency list for sparse implementation.
         std::vector<std::list<std::pair<int,int>>> adj_list;
+        //optional hash of the edges for O(1) isEdge/getWeight
+        std::unique_ptr<EdgeIndex> index;
+
+        void build(const Adjacency &adj, const int threads);
     public:
     //Constructors 
         SparseGraph(void);
         SparseGraph(const int V, const int E);
+        //Parallel construction, same graph as inserting the edges one by one
+        SparseGraph(const int V, const int E, const std::vector<std::tuple<int,int,int>> &edge_list, const int threads);
+        SparseGraph(const int V, const int E, std::istream &is, const int threads);
         SparseGraph(const SparseGraph &other);
     // Assignment Operators
         SparseGraph& operator=(const SparseGraph &other);
@@ -31,6 +44,17 @@ class SparseGraph : public Graph {
         void insertEdge(const int v1, const int v2, int w) override;
         bool isEdge(const int v1, const int v2) const override;
         int getWeight(const int v1, const int v2) const override;
+        void getWeights(const std::vector<std::pair<int,int>> &pairs, std::vector<int> &out) const override;
+        void getNeighbors(const int v, std::vector<std::pair<int,int>> &out) const override;
+        const std::list<std::pair<int,int>>& neighbors(const int v) const;
+
+        //Edge index, kept up to date by insertEdge once built
+        void buildEdgeIndex(void);
+        void dropEdgeIndex(void) { index.reset(); }
+        bool hasEdgeIndex(void) const { return index != nullptr; }
+
+        //Copy of the graph with vertex v renamed to perm[v]
+        SparseGraph*    relabel (const std::vector<int> &perm) const;
 
         //BFS-based Algorithms
         void BFS(int source) override;
@@ -41,6 +65,9 @@ class SparseGraph : public Graph {
 
         // project 7 algorithms 
         SparseGraph*    MST_Prim (void) override;
+        SparseGraph*    MST_Prim (const int root);
+        SparseGraph*    MST_PrimHeap (const int root);
+        SparseGraph*    MST_PrimBucket (const int root);
         SparseGraph*    MST_Kruskal (void) override;
 };
 
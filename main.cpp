@@ -5,50 +5,171 @@
 // This file assumes the A-level implementation for Project 6
 // and the A-level implementation for Project 7.  Comment out
 // the parts that won't work with your choices.
+//
+// The backend (SparseGraph or DenseGraph) and the MST algorithm are
+// picked by the graph factory from the "nv ne" header.  They can be
+// overridden on the command line:
+//    --sparse | --dense      force the backend
+//    --prim   | --kruskal    force the MST algorithm
+//    --reorder=ORDER         relabel a SparseGraph for locality
+//                            (bfs, rcm, degree or none)
+//    --dedup                 drop self-loops and parallel edges
+//                            (keeping the lightest) before building
+//    --threads=N             parse and build the graph (and run a
+//                            dense Kruskal) with N threads
+//                            (0 for one per hardware thread)
+//    --binary=FILE           also write the MST to FILE in the binary
+//                            format of GraphIO.h
+//    --quiet                 do not log the factory decision
+//    --fuzz[=SECONDS]        cross-check every MST algorithm of every
+//                            backend on random graphs until the first
+//                            failure (or SECONDS); nothing is read
+//    --fuzz-ci               the same, on a fixed set of small cases
+//    --seed=N                first seed of the fuzz cases
+//    --points[=METHOD]       read "nv dim" and nv points instead of a
+//                            graph and print their Euclidean MST
+//                            (METHOD: kdtree or prim, default auto)
+//    --serve=PATH            answer MST requests on the Unix socket
+//                            PATH (see Server.h) with --threads
+//                            workers (default one per hardware thread)
 //================================================================
 
 #include "Graph.h"
-//#include "DenseGraph.h"       // remove this for B-level
-#include "SparseGraph.h"      // remove this for B-level
+#include "DenseGraph.h"
+#include "SparseGraph.h"
+#include "GraphFactory.h"
+#include "Parallel.h"
+#include "GraphIO.h"
+#include "Fuzz.h"
+#include "Server.h"
+#include "EuclideanMST.h"
+#include <fstream>
 #include <iostream>
+#include <string>
+#include <stdexcept>
 using namespace std;
 
-int main ( void )
+int main ( int argc, char *argv[] )
 {
-   Graph *gp, *mstp, *mstk;
+   Graph *gp, *mstp;
+   GraphOptions opts;
+   GraphChoice choice;
+   string binary_path, socket_path;
+   int status = 0;
+   FuzzOptions fuzz;
+   bool fuzzing = false;
+   bool points = false;
+   bool threads_given = false;
+   EuclideanMethod method = EuclideanMethod::AUTO;
 
-   int nv, ne;
-   cin >> nv >> ne;
-   // For Project 6 A-level, test both the sparse and dense implementations
-   // of MST algorithms, but leave it with the sparse implementation.
-   //gp = new DenseGraph(nv,ne);
-   gp = new SparseGraph(nv,ne);
+   // nothing is read with the C streams, so the C++ ones need not stay in sync
+   ios::sync_with_stdio(false);
 
-   // For Project 6 B-level, test this instead
-   //gp = new Graph(nv,ne);
+   // a malformed value (--threads=x) is reported like an unknown flag
+   bool bad_args = false;
+   try {
+      for (int i = 1; i < argc; ++i) {
+         string arg = argv[i];
+         if (arg == "--sparse")        opts.backend = Backend::SPARSE;
+         else if (arg == "--dense")    opts.backend = Backend::DENSE;
+         else if (arg == "--prim")     opts.algorithm = MSTAlgorithm::PRIM;
+         else if (arg == "--kruskal")  opts.algorithm = MSTAlgorithm::KRUSKAL;
+         else if (arg == "--quiet")    opts.log = nullptr;
+         else if (arg == "--dedup")    opts.dedup = true;
+         else if (arg.rfind("--reorder=", 0) == 0)
+            opts.ordering = parseOrdering(arg.substr(10));
+         else if (arg.rfind("--threads=", 0) == 0) {
+            opts.threads = stoi(arg.substr(10));
+            threads_given = true;
+            if (opts.threads <= 0)
+               opts.threads = defaultThreads();
+         }
+         else if (arg.rfind("--binary=", 0) == 0)
+            binary_path = arg.substr(9);
+         else if (arg == "--fuzz")     fuzzing = true;
+         else if (arg.rfind("--fuzz=", 0) == 0) {
+            fuzzing = true;
+            fuzz.seconds = stod(arg.substr(7));
+         }
+         else if (arg == "--fuzz-ci") {
+            fuzzing = true;
+            fuzz.cases = FUZZ_CI_CASES;
+            fuzz.max_vertices = FUZZ_CI_VERTICES;
+         }
+         else if (arg.rfind("--seed=", 0) == 0)
+            fuzz.seed = stoul(arg.substr(7));
+         else if (arg == "--points")   points = true;
+         else if (arg == "--points=kdtree" or arg == "--points=prim") {
+            points = true;
+            method = (arg == "--points=prim") ? EuclideanMethod::PRIM : EuclideanMethod::KDTREE;
+         }
+         else if (arg.rfind("--serve=", 0) == 0)
+            socket_path = arg.substr(8);
+         else {
+            bad_args = true;
+            break;
+         }
+      }
+   }
+   catch (const exception &) {
+      bad_args = true;
+   }
+   if (bad_args) {
+      cerr << "usage: " << argv[0] << " [--sparse|--dense] [--prim|--kruskal] [--reorder=ORDER] [--dedup] [--threads=N] [--binary=FILE] [--quiet] < graph" << endl;
+      cerr << "       " << argv[0] << " --fuzz[=SECONDS] | --fuzz-ci [--seed=N]" << endl;
+      cerr << "       " << argv[0] << " --serve=PATH [--threads=N]" << endl;
+      cerr << "       " << argv[0] << " --points[=kdtree|prim] < points" << endl;
+      return 1;
+   }
 
-   cin >> (*gp);
+   if (fuzzing) {
+      FuzzReport report = runFuzz(fuzz);
+      cout << "Fuzz: " << report.cases << " cases, " << report.checks << " MSTs checked, "
+           << report.failures << " failures" << endl;
+      if (report.failures)
+         cout << "First failure: " << report.first_failure << endl;
+      return report.failures ? 1 : 0;
+   }
+
+   if (points) {
+      PointSet ps;
+      EuclideanTree tree;
+      readPoints(cin, ps);
+      euclideanMST(ps, tree, method);
+      cout << tree;
+      return 0;
+   }
+
+   if (!socket_path.empty()) {
+      MSTServer server(socket_path, threads_given ? opts.threads : defaultThreads());
+      if (opts.log)
+         *opts.log << "MSTServer: listening on " << socket_path << endl;
+      server.run();
+      return 0;
+   }
+
+   gp = readGraph(cin, choice, opts);
    cout << "Printing the graph that was read in:\n";
    cout << (*gp);
 
    // required for Project 7 A and B level
    cout << endl << endl;
-   mstp = gp->MST_Prim();
-   cout << "MST (Prim) is: \n";
+   mstp = computeMST(*gp, choice.algorithm, opts.threads);
+   cout << "MST (" << toString(choice.algorithm) << ") is: \n";
    cout << (*mstp) << endl;
+   if (!binary_path.empty()) {
+      ofstream bout(binary_path, ios::binary);
+      if (bout)
+         writeBinary(bout, *mstp);
+      else {
+         cerr << "cannot open " << binary_path << endl;
+         status = 1;
+      }
+   }
    //cout << "MST mass = " << mstp->mass() << endl;
 
-   // for A-level on Project 7
-   // comment this out if you only implement Prim
-   //cout << endl << endl;
-   //mstk = gp->MST_Kruskal();
-   //cout << "MST (Kruskal) is: \n";
-   //cout << (*mstk) << endl;
-   //cout << "MST mass = " << mstk->mass() << endl;
-
    // remove graphs
    delete gp;
    delete mstp;
-   //delete mstk;      // comment out if not used
-   return 0;
+   return status;
 }